@@ -0,0 +1,110 @@
+#ifndef LEARNQL_BENCHMARKS_BENCH_COMMON_HPP
+#define LEARNQL_BENCHMARKS_BENCH_COMMON_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace learnql::bench {
+
+/**
+ * @brief Runs a callable once and returns the elapsed wall time in seconds
+ */
+template<typename Fn>
+double time_seconds(Fn&& fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+/**
+ * @brief Returns a fresh path in the temp directory (any old file is removed)
+ */
+inline std::string temp_db_path(const std::string& name) {
+    auto path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(path);
+    std::filesystem::remove(path.string() + ".wal");
+    return path.string();
+}
+
+/**
+ * @brief Generates a reproducible sequence of uniformly random page IDs
+ * @param count Number of IDs
+ * @param first Smallest ID (inclusive)
+ * @param last Largest ID (inclusive)
+ */
+inline std::vector<uint64_t> random_ids(std::size_t count, uint64_t first, uint64_t last,
+                                        uint32_t seed = 42) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<uint64_t> dist(first, last);
+    std::vector<uint64_t> ids(count);
+    for (auto& id : ids) {
+        id = dist(rng);
+    }
+    return ids;
+}
+
+/**
+ * @brief Prints a section header
+ */
+inline void print_header(const std::string& title) {
+    std::cout << "\n" << title << "\n" << std::string(title.size(), '=') << "\n";
+}
+
+/**
+ * @brief Prints one result row: name, operations, seconds, throughput
+ */
+inline void print_row(const std::string& name, std::size_t ops, double seconds) {
+    std::cout << std::left << std::setw(40) << name
+              << std::right << std::setw(10) << ops << " ops"
+              << std::setw(12) << std::fixed << std::setprecision(3) << seconds * 1000.0 << " ms"
+              << std::setw(14) << std::fixed << std::setprecision(0)
+              << (seconds > 0 ? ops / seconds : 0.0) << " ops/s\n";
+}
+
+/**
+ * @brief Prints the ratio between a baseline and a candidate timing
+ */
+inline void print_speedup(const std::string& label, double baseline_seconds, double candidate_seconds) {
+    std::cout << label << ": " << std::fixed << std::setprecision(2)
+              << (candidate_seconds > 0 ? baseline_seconds / candidate_seconds : 0.0) << "x\n";
+}
+
+/**
+ * @brief Returns the p-th percentile (0-100) of a set of samples
+ * @details Sorts the samples in place (nearest-rank method).
+ */
+inline double percentile(std::vector<double>& samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto rank = static_cast<std::size_t>(p / 100.0 * static_cast<double>(samples.size() - 1) + 0.5);
+    return samples[std::min(rank, samples.size() - 1)];
+}
+
+/**
+ * @brief Prints latency percentiles of per-operation samples given in seconds
+ */
+inline void print_latency(const std::string& name, std::vector<double>& samples) {
+    double p50 = percentile(samples, 50.0);
+    double p99 = percentile(samples, 99.0);
+    double p999 = percentile(samples, 99.9);
+    double max = samples.empty() ? 0.0 : samples.back();
+    std::cout << std::left << std::setw(40) << name << std::right << std::fixed << std::setprecision(1)
+              << "p50 " << std::setw(8) << p50 * 1e6 << " us"
+              << "  p99 " << std::setw(8) << p99 * 1e6 << " us"
+              << "  p99.9 " << std::setw(9) << p999 * 1e6 << " us"
+              << "  max " << std::setw(9) << max * 1e6 << " us\n";
+}
+
+} // namespace learnql::bench
+
+#endif // LEARNQL_BENCHMARKS_BENCH_COMMON_HPP
@@ -0,0 +1,160 @@
+/**
+ * @file async_io_benchmark.cpp
+ * @brief Leaf-chain scans and scattered flushes with each I/O backend
+ *
+ * Every run starts with the database file dropped from the OS page cache
+ * (posix_fadvise DONTNEED after an fsync), so reads go to the device.
+ *
+ * - "index scan": a cold PersistentBTreeIndex::get_all() walks the leaf
+ *   chain. With an asynchronous backend the next leaves are prefetched in
+ *   batches, so the device sees many reads at once instead of one per leaf.
+ * - "scattered flush": every fifth page is rewritten, then flush_all() writes
+ *   them. Most runs are a single page long; an asynchronous backend
+ *   submits all of them in one batch.
+ *
+ * The database uses 16KB pages. Readahead finds the next leaves through
+ * the internal nodes above them, which it reads too; with 4KB pages (B+tree
+ * fanout 4) those are nearly as many as the leaves.
+ *
+ * Results depend heavily on the device: on NVMe the batched backends keep
+ * its queues busy, while on a single spinning disk (or when the page cache
+ * cannot be dropped) the three backends come out close.
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/storage/StorageEngine.hpp>
+#include <learnql/index/PersistentBTreeIndex.hpp>
+#include <fcntl.h>
+#include <memory>
+
+using namespace learnql;
+
+namespace {
+
+constexpr std::size_t NUM_KEYS = 20000;
+constexpr std::size_t NUM_DIRTY = 4000;
+constexpr std::size_t CACHE_PAGES = 512;
+constexpr std::size_t PAGE_SIZE = 16384;  // B+tree fanout 16: internal nodes are few next to the leaves
+
+using Index = index::PersistentBTreeIndex<int64_t, core::RecordId>;
+
+/**
+ * @brief Asks the OS to drop a file from its page cache
+ */
+void drop_os_cache(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+}
+
+uint64_t build_index(const std::string& path) {
+    storage::StorageOptions options;
+    options.cache_size = 1024;
+    options.page_size = PAGE_SIZE;
+    auto engine = std::make_shared<storage::StorageEngine>(path, options);
+
+    Index index(engine);
+    for (std::size_t i = 0; i < NUM_KEYS; ++i) {
+        index.insert(static_cast<int64_t>(i), core::RecordId{i, 0});
+    }
+    index.flush();
+    engine->flush_all();
+    return index.get_root_page_id();
+}
+
+storage::StorageOptions options_for(storage::IoBackend backend) {
+    storage::StorageOptions options;
+    options.cache_size = CACHE_PAGES;
+    options.io_backend = backend;
+    return options;
+}
+
+double run_scan(const std::string& path, uint64_t root, storage::IoBackend backend) {
+    drop_os_cache(path);
+    auto engine = std::make_shared<storage::StorageEngine>(path, options_for(backend));
+    Index index(engine, root);
+
+    std::size_t entries = 0;
+    double seconds = bench::time_seconds([&] {
+        entries = index.get_all().size();
+    });
+
+    auto stats = engine->get_io_stats();
+    bench::print_row(std::string("index scan (") + engine->get_io_backend() + ")", entries, seconds);
+    std::cout << "  " << stats.pages_read << " pages read, " << stats.prefetched_pages << " prefetched in "
+              << stats.async_batches << " batches\n";
+    return seconds;
+}
+
+double run_flush(const std::string& path, const std::vector<uint64_t>& pages, storage::IoBackend backend) {
+    drop_os_cache(path);
+    auto options = options_for(backend);
+    options.cache_size = 4 * pages.size();  // Nothing is written back before the flush
+    storage::StorageEngine engine(path, options);
+
+    // Dirty the pages without reading them: their contents are replaced
+    for (uint64_t page_id : pages) {
+        auto page = engine.reset_page(page_id, storage::PageType::DATA);
+        page->write_data(0, &page_id, sizeof(page_id));
+    }
+    engine.reset_io_stats();
+
+    double seconds = bench::time_seconds([&] {
+        engine.flush_all();
+    });
+
+    auto stats = engine.get_io_stats();
+    bench::print_row(std::string("scattered flush (") + engine.get_io_backend() + ")", stats.flushed_pages, seconds);
+    std::cout << "  " << stats.flush_runs << " runs in " << stats.async_batches << " batches\n";
+    return seconds;
+}
+
+} // namespace
+
+int main() {
+    const storage::IoBackend backends[] = {storage::IoBackend::SYNC, storage::IoBackend::THREAD_POOL,
+                                           storage::IoBackend::IO_URING};
+
+    auto path = bench::temp_db_path("learnql_async_io.db");
+    uint64_t root = build_index(path);
+
+    bench::print_header("Cold leaf-chain scan (" + std::to_string(NUM_KEYS) + " keys, 16 KB pages)");
+    double scan_sync = 0.0;
+    for (auto backend : backends) {
+        double seconds = run_scan(path, root, backend);
+        if (backend == storage::IoBackend::SYNC) {
+            scan_sync = seconds;
+        } else {
+            bench::print_speedup("  speedup over sync", scan_sync, seconds);
+        }
+    }
+
+    // Scattered pages below the end of the file (every 5th page)
+    uint64_t page_count = 0;
+    {
+        storage::StorageEngine engine(path, CACHE_PAGES);
+        page_count = engine.get_page_count();
+    }
+    std::vector<uint64_t> pages;
+    for (uint64_t page_id = 1; page_id < page_count && pages.size() < NUM_DIRTY; page_id += 5) {
+        pages.push_back(page_id);
+    }
+
+    bench::print_header("Flush of " + std::to_string(pages.size()) + " scattered pages");
+    double flush_sync = 0.0;
+    for (auto backend : backends) {
+        auto copy = bench::temp_db_path("learnql_async_io_flush.db");
+        std::filesystem::copy_file(path, copy);
+        double seconds = run_flush(copy, pages, backend);
+        if (backend == storage::IoBackend::SYNC) {
+            flush_sync = seconds;
+        } else {
+            bench::print_speedup("  speedup over sync", flush_sync, seconds);
+        }
+    }
+
+    return 0;
+}
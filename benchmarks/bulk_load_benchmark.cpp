@@ -0,0 +1,103 @@
+/**
+ * @file bulk_load_benchmark.cpp
+ * @brief Loading a table with secondary indexes: insert() per row vs insert_batch()
+ *
+ * The rows arrive in random primary key order. Two ways to load them:
+ *
+ * - insert(): one row at a time; every row does a primary key lookup, a
+ *   page placement, one insert per index and a catalog count update
+ * - insert_batch(): rows sorted by key and written into pages filled one
+ *   after another; the indexes are bulk-built from sorted entries and the
+ *   catalog is updated once
+ *
+ * A second batch as large as the first is then loaded into the non-empty
+ * table, which merges it into the existing indexes.
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/LearnQL.hpp>
+#include <algorithm>
+#include <random>
+
+using namespace learnql;
+
+namespace {
+
+constexpr int NUM_RECORDS = 10000;
+
+class Customer {
+    LEARNQL_PROPERTIES_BEGIN(Customer)
+        LEARNQL_PROPERTY(int, id, PK)
+        LEARNQL_PROPERTY(std::string, email)
+        LEARNQL_PROPERTY(int, region)
+        LEARNQL_PROPERTY(double, balance)
+    LEARNQL_PROPERTIES_END(
+        PROP(int, id, PK),
+        PROP(std::string, email),
+        PROP(int, region),
+        PROP(double, balance)
+    )
+
+public:
+    Customer() = default;
+    explicit Customer(int id)
+        : id_(id),
+          email_("customer" + std::to_string(id) + "@example.com"),
+          region_(id % 50),
+          balance_(id * 1.5) {}
+};
+
+/**
+ * @brief Rows with IDs first, first + 2, ... in random order
+ */
+std::vector<Customer> make_rows(int first, unsigned seed) {
+    std::vector<Customer> rows;
+    rows.reserve(NUM_RECORDS);
+    for (int i = 0; i < NUM_RECORDS; ++i) {
+        rows.emplace_back(first + 2 * i);
+    }
+    std::shuffle(rows.begin(), rows.end(), std::mt19937(seed));
+    return rows;
+}
+
+void run(const std::string& path, bool batch) {
+    core::Database db(path);
+    auto& customers = db.table<Customer>("customers")
+        .add_index(Customer::email, core::IndexType::Unique)
+        .add_index(Customer::region, core::IndexType::MultiValue);
+
+    auto load = [&](const std::vector<Customer>& rows) {
+        if (batch) {
+            customers.insert_batch(rows);
+        } else {
+            for (const auto& row : rows) {
+                customers.insert(row);
+            }
+        }
+        customers.flush();
+    };
+
+    auto first = make_rows(0, 1);
+    auto second = make_rows(1, 2);
+    auto& engine = db.get_storage();
+    engine.reset_io_stats();
+    double seconds = bench::time_seconds([&] { load(first); });
+    bench::print_row(batch ? "insert_batch (empty table)" : "insert (empty table)", NUM_RECORDS, seconds);
+    seconds = bench::time_seconds([&] { load(second); });
+    bench::print_row(batch ? "insert_batch (non-empty table)" : "insert (non-empty table)", NUM_RECORDS, seconds);
+    std::cout << "  pages written: " << engine.get_io_stats().pages_written
+              << ", file size: " << std::filesystem::file_size(path) / 1024 << " KB\n";
+
+    if (customers.size() != 2 * NUM_RECORDS || !customers.find_by(Customer::email, std::string("customer77@example.com"))) {
+        std::cout << "  (load mismatch)\n";
+    }
+}
+
+} // namespace
+
+int main() {
+    bench::print_header(std::to_string(NUM_RECORDS) + " rows in random key order, twice, 2 secondary indexes");
+    run(bench::temp_db_path("learnql_bulk_load_rows.db"), false);
+    run(bench::temp_db_path("learnql_bulk_load_batch.db"), true);
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file catalog_count_benchmark.cpp
+ * @brief Cost of keeping the catalog's record count on small inserts and removes
+ *
+ * Every insert() and remove() on a table opened through a Database reports
+ * the new record count to the system catalog. The catalog keeps counts in
+ * memory and writes them to _sys_tables at flush, so a catalog table
+ * should cost the same per row as a Table created without one.
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/LearnQL.hpp>
+
+using namespace learnql;
+
+namespace {
+
+constexpr int NUM_RECORDS = 5000;
+
+class Event {
+    LEARNQL_PROPERTIES_BEGIN(Event)
+        LEARNQL_PROPERTY(int, id, PK)
+        LEARNQL_PROPERTY(int, kind)
+    LEARNQL_PROPERTIES_END(
+        PROP(int, id, PK),
+        PROP(int, kind)
+    )
+
+public:
+    Event() = default;
+    Event(int id, int kind) : id_(id), kind_(kind) {}
+};
+
+template<typename TableType>
+void run(const std::string& name, TableType& events) {
+    double seconds = bench::time_seconds([&] {
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            events.insert(Event(i, i % 7));
+        }
+        for (int i = 0; i < NUM_RECORDS; i += 2) {
+            events.remove(i);
+        }
+    });
+    bench::print_row(name, NUM_RECORDS + NUM_RECORDS / 2, seconds);
+}
+
+} // namespace
+
+int main() {
+    bench::print_header(std::to_string(NUM_RECORDS) + " inserts + " + std::to_string(NUM_RECORDS / 2) +
+                        " removes of small records");
+
+    {
+        auto storage = std::make_shared<storage::StorageEngine>(bench::temp_db_path("learnql_catalog_count_plain.db"));
+        core::Table<Event> plain(storage, "events");
+        run("table without catalog", plain);
+    }
+
+    core::Database db(bench::temp_db_path("learnql_catalog_count.db"));
+    auto& cataloged = db.table<Event>("events");
+    run("catalog table (count reported)", cataloged);
+
+    for (const auto& meta : db.metadata().tables().where(catalog::TableMetadata::name == std::string("events"))) {
+        std::cout << "  catalog record_count: " << meta.get_record_count()
+                  << " (table size " << cataloged.size() << ")\n";
+    }
+    return 0;
+}
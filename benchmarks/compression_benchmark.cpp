@@ -0,0 +1,154 @@
+/**
+ * @file compression_benchmark.cpp
+ * @brief Page compression: file size, load throughput and cold scan throughput
+ *
+ * The same table is loaded into an uncompressed and an LZ-compressed
+ * database. Records mix repeated strings (city, status) with unique ones,
+ * like typical application data; each record sits on its own page, so most
+ * of every page is free space, which compresses to almost nothing.
+ *
+ * - "load": inserts plus the final flush (compression happens at write-back)
+ * - "cold scan": every page of the file read in page order after the file
+ *   was dropped from the OS page cache (one decompression per page read;
+ *   ops counts the pages)
+ *
+ * The ratio is page bytes written per byte stored (IoStats::compression_ratio).
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/LearnQL.hpp>
+#include <fcntl.h>
+
+using namespace learnql;
+
+namespace {
+
+constexpr int NUM_RECORDS = 20000;
+constexpr std::size_t CACHE_PAGES = 256;
+
+class Customer {
+    LEARNQL_PROPERTIES_BEGIN(Customer)
+        LEARNQL_PROPERTY(int, id, PK)
+        LEARNQL_PROPERTY(std::string, name)
+        LEARNQL_PROPERTY(std::string, city)
+        LEARNQL_PROPERTY(std::string, status)
+        LEARNQL_PROPERTY(double, balance)
+    LEARNQL_PROPERTIES_END(
+        PROP(int, id, PK),
+        PROP(std::string, name),
+        PROP(std::string, city),
+        PROP(std::string, status),
+        PROP(double, balance)
+    )
+
+public:
+    Customer() = default;
+    Customer(int id, std::string name, std::string city, std::string status, double balance)
+        : id_(id), name_(std::move(name)), city_(std::move(city)), status_(std::move(status)), balance_(balance) {}
+};
+
+/**
+ * @brief Asks the OS to drop a file from its page cache
+ */
+void drop_os_cache(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+}
+
+storage::StorageOptions options_for(storage::PageCompression compression) {
+    storage::StorageOptions options;
+    options.cache_size = CACHE_PAGES;
+    options.compression = compression;
+    return options;
+}
+
+std::string label(const char* what, storage::PageCompression compression) {
+    return std::string(what) + (compression == storage::PageCompression::NONE ? " (uncompressed)" : " (LZ)");
+}
+
+/**
+ * @brief Loads the table and returns the file size
+ */
+std::uintmax_t run_load(const std::string& path, storage::PageCompression compression) {
+    static const char* cities[] = {"Istanbul", "Ankara", "Izmir", "Bursa", "Antalya"};
+    static const char* statuses[] = {"active", "inactive", "suspended"};
+
+    storage::IoStats stats;
+    std::size_t page_size = 0;
+    double seconds = 0.0;
+    {
+        core::Database db(path, options_for(compression));
+        auto& customers = db.table<Customer>("customers");
+        seconds = bench::time_seconds([&] {
+            for (int i = 0; i < NUM_RECORDS; ++i) {
+                customers.insert(Customer(i, "Customer #" + std::to_string(i), cities[i % 5], statuses[i % 3],
+                                          i * 1.25));
+            }
+            customers.flush();
+            db.flush();
+        });
+        stats = db.get_storage().get_io_stats();
+        page_size = db.get_storage().get_page_size();
+    }
+
+    bench::print_row(label("load", compression), NUM_RECORDS, seconds);
+    std::uintmax_t size = std::filesystem::file_size(path);
+    std::cout << "  file " << size / 1024 << " KB";
+    if (compression != storage::PageCompression::NONE) {
+        std::cout << ", ratio " << std::fixed << std::setprecision(1) << stats.compression_ratio(page_size) << "x";
+    }
+    std::cout << "\n";
+    return size;
+}
+
+double run_scan(const std::string& path, storage::PageCompression compression) {
+    drop_os_cache(path);
+    storage::StorageEngine engine(path, options_for(compression));
+    uint64_t pages = engine.get_page_count();
+
+    std::size_t scanned = 0;
+    double seconds = bench::time_seconds([&] {
+        for (uint64_t page_id = 1; page_id < pages; ++page_id) {
+            if (engine.is_page_allocated(page_id)) {
+                auto page = engine.fetch_page(page_id);
+                ++scanned;
+            }
+        }
+    });
+
+    bench::print_row(label("cold scan", compression), scanned, seconds);
+    return seconds;
+}
+
+} // namespace
+
+int main() {
+    const storage::PageCompression modes[] = {storage::PageCompression::NONE, storage::PageCompression::LZ};
+
+    const std::string paths[] = {bench::temp_db_path("learnql_compression_none.db"),
+                                 bench::temp_db_path("learnql_compression_lz.db")};
+
+    bench::print_header("Load of " + std::to_string(NUM_RECORDS) + " records");
+    std::uintmax_t sizes[2] = {};
+    for (int i = 0; i < 2; ++i) {
+        sizes[i] = run_load(paths[i], modes[i]);
+    }
+    std::cout << "  file size reduction: " << std::fixed << std::setprecision(1)
+              << static_cast<double>(sizes[0]) / static_cast<double>(sizes[1]) << "x\n";
+
+    bench::print_header("Cold scan of every page");
+    double baseline = 0.0;
+    for (int i = 0; i < 2; ++i) {
+        double seconds = run_scan(paths[i], modes[i]);
+        if (i == 0) {
+            baseline = seconds;
+        } else {
+            bench::print_speedup("  speedup over uncompressed", baseline, seconds);
+        }
+    }
+    return 0;
+}
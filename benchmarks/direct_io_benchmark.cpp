@@ -0,0 +1,105 @@
+/**
+ * @file direct_io_benchmark.cpp
+ * @brief Buffered vs. direct (O_DIRECT) page I/O: time and OS page cache use
+ *
+ * The engine's buffer pool is sized to hold the whole database, then a
+ * cold random read pass and a warm pass run over it. After each mode the
+ * file's footprint in the OS page cache is measured with mincore(): with
+ * buffered I/O every page the engine caches is also cached by the kernel,
+ * with direct I/O the buffer pool holds the only copy.
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/storage/StorageEngine.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+using namespace learnql;
+
+namespace {
+
+constexpr std::size_t NUM_PAGES = 20000;
+constexpr std::size_t NUM_READS = 50000;
+
+/**
+ * @brief Asks the OS to drop a file from its page cache
+ */
+void drop_os_cache(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+}
+
+/**
+ * @brief Bytes of a file currently held in the OS page cache
+ */
+std::size_t os_cached_bytes(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return 0;
+    }
+    std::size_t size = std::filesystem::file_size(path);
+    std::size_t os_page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::size_t cached = 0;
+
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping != MAP_FAILED) {
+        std::vector<unsigned char> resident((size + os_page - 1) / os_page);
+        if (::mincore(mapping, size, resident.data()) == 0) {
+            for (unsigned char flags : resident) {
+                cached += (flags & 1) ? os_page : 0;
+            }
+        }
+        ::munmap(mapping, size);
+    }
+    ::close(fd);
+    return cached;
+}
+
+void run(const std::string& path, bool direct) {
+    drop_os_cache(path);
+
+    storage::StorageOptions options;
+    options.cache_size = NUM_PAGES + 64;  // The buffer pool holds every page
+    options.direct_io = direct;
+    storage::StorageEngine engine(path, options);
+
+    auto ids = bench::random_ids(NUM_READS, 1, NUM_PAGES, 11);
+    auto read_all = [&] {
+        for (uint64_t page_id : ids) {
+            auto page = engine.fetch_page(page_id);
+        }
+    };
+
+    std::string mode = engine.is_direct_io() ? "direct" : "buffered";
+    bench::print_row("cold random reads (" + mode + ")", NUM_READS, bench::time_seconds(read_all));
+    bench::print_row("warm random reads (" + mode + ")", NUM_READS, bench::time_seconds(read_all));
+    std::cout << "  buffer pool: " << engine.get_io_stats().pages_read * engine.get_page_size() / (1024 * 1024)
+              << " MB read, OS page cache: " << os_cached_bytes(path) / (1024 * 1024) << " MB of the file\n";
+
+    if (direct && !engine.is_direct_io()) {
+        std::cout << "  (this file system does not support O_DIRECT; buffered I/O was used)\n";
+    }
+}
+
+} // namespace
+
+int main() {
+    auto path = bench::temp_db_path("learnql_direct_io.db");
+    {
+        storage::StorageEngine engine(path, 256);
+        for (std::size_t i = 0; i < NUM_PAGES; ++i) {
+            auto page = engine.new_page(storage::PageType::DATA);
+            page->write_data(0, &i, sizeof(i));
+        }
+        engine.flush_all();
+    }
+
+    bench::print_header("Random reads over " + std::to_string(NUM_PAGES) + " pages");
+    run(path, false);
+    run(path, true);
+    return 0;
+}
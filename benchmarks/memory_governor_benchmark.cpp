@@ -0,0 +1,127 @@
+/**
+ * @file memory_governor_benchmark.cpp
+ * @brief Independent cache sizes vs. one governed memory budget
+ *
+ * A database with many B+tree indexes is opened twice with the same
+ * memory:
+ *
+ * - "independent": the buffer pool gets what is left after every index
+ *   keeps its fixed 32-node cache (so each added index costs memory)
+ * - "governed": a MemoryGovernor divides the same budget and moves it
+ *   towards the caches that miss most
+ *
+ * The workload has two phases: lookups concentrated on a few indexes,
+ * then random reads over a hot set of data pages. Pages read from the file
+ * (IoStats::pages_read) show how well each split served each phase.
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/storage/StorageEngine.hpp>
+#include <learnql/index/PersistentBTreeIndex.hpp>
+
+using namespace learnql;
+
+namespace {
+
+constexpr std::size_t NUM_INDEXES = 30;
+constexpr int KEYS_PER_INDEX = 400;
+constexpr std::size_t HOT_INDEXES = 3;
+constexpr std::size_t DATA_PAGES = 6000;
+constexpr std::size_t HOT_PAGES = 1200;
+constexpr std::size_t NUM_LOOKUPS = 200000;
+constexpr std::size_t NUM_READS = 200000;
+constexpr std::size_t BUDGET_BYTES = 6 * 1024 * 1024;
+constexpr std::size_t NODE_CACHE = 32;  // PersistentBTreeIndex's fixed node cache
+
+using Index = index::PersistentBTreeIndex<int, core::RecordId>;
+
+/**
+ * @brief Builds the file and returns the indexes' root pages
+ */
+std::vector<uint64_t> build(const std::string& path) {
+    auto engine = std::make_shared<storage::StorageEngine>(path, 256);
+    for (std::size_t i = 0; i < DATA_PAGES; ++i) {
+        auto page = engine->new_page(storage::PageType::DATA);
+        page->write_data(0, &i, sizeof(i));
+    }
+
+    std::vector<uint64_t> roots;
+    for (std::size_t i = 0; i < NUM_INDEXES; ++i) {
+        Index index(engine);
+        for (int key = 0; key < KEYS_PER_INDEX; ++key) {
+            index.insert(key, core::RecordId{static_cast<uint64_t>(key), 0});
+        }
+        index.flush();
+        roots.push_back(index.get_root_page_id());
+    }
+    engine->flush_all();
+    return roots;
+}
+
+void run(const std::string& path, const std::vector<uint64_t>& roots, bool governed) {
+    std::size_t page_size = storage::PAGE_SIZE;
+    storage::StorageOptions options;
+    options.cache_size = BUDGET_BYTES / page_size - NUM_INDEXES * NODE_CACHE;
+    options.readahead_pages = 0;
+    auto engine = std::make_shared<storage::StorageEngine>(path, options);
+
+    std::shared_ptr<storage::MemoryGovernor> governor;
+    if (governed) {
+        governor = std::make_shared<storage::MemoryGovernor>(BUDGET_BYTES, 0.0);
+        engine->set_memory_governor(governor);
+    }
+
+    std::vector<std::unique_ptr<Index>> indexes;
+    for (uint64_t root : roots) {
+        indexes.push_back(std::make_unique<Index>(engine, root));
+    }
+
+    std::string mode = governed ? " (governed)" : " (independent)";
+    auto keys = bench::random_ids(NUM_LOOKUPS, 0, KEYS_PER_INDEX - 1, 5);
+    engine->reset_io_stats();
+    std::size_t found = 0;
+    double seconds = bench::time_seconds([&] {
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            found += indexes[i % HOT_INDEXES]->find(static_cast<int>(keys[i])).has_value() ? 1 : 0;
+        }
+    });
+    if (found != NUM_LOOKUPS) {
+        std::cout << "  (" << NUM_LOOKUPS - found << " keys not found)\n";
+    }
+    bench::print_row("hot index lookups" + mode, NUM_LOOKUPS, seconds);
+    std::cout << "  pages read: " << engine->get_io_stats().pages_read << "\n";
+
+    auto pages = bench::random_ids(NUM_READS, 1, HOT_PAGES, 7);
+    engine->reset_io_stats();
+    seconds = bench::time_seconds([&] {
+        for (uint64_t page_id : pages) {
+            auto page = engine->fetch_page(page_id);
+        }
+    });
+    bench::print_row("hot page reads" + mode, NUM_READS, seconds);
+    std::cout << "  pages read: " << engine->get_io_stats().pages_read << "\n";
+
+    if (governor) {
+        std::size_t node_bytes = 0;
+        for (const auto& share : governor->shares()) {
+            node_bytes += share.name == "buffer pool" ? 0 : share.limit_bytes;
+        }
+        std::cout << "  final split: buffer pool " << engine->get_cache_size() << " pages, index nodes "
+                  << node_bytes / page_size << " nodes, " << governor->rebalance_count() << " rebalances\n";
+    }
+}
+
+} // namespace
+
+int main() {
+    auto path = bench::temp_db_path("learnql_memory_governor.db");
+    auto roots = build(path);
+
+    bench::print_header(std::to_string(NUM_INDEXES) + " indexes, " + std::to_string(BUDGET_BYTES / (1024 * 1024)) +
+                        " MB of cache memory");
+    std::cout << "  independent caches: " << NODE_CACHE * NUM_INDEXES * storage::PAGE_SIZE / 1024
+              << " KB of it fixed in node caches (grows with every index)\n";
+    run(path, roots, false);
+    run(path, roots, true);
+    return 0;
+}
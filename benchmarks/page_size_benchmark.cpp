@@ -0,0 +1,140 @@
+/**
+ * @file page_size_benchmark.cpp
+ * @brief Full scans and indexed point lookups at 4KB, 16KB and 64KB pages
+ *
+ * For each page size the same NUM_RECORDS fixed-size records are packed
+ * into DATA pages and indexed by a PersistentBTreeIndex. Every run gets the
+ * same buffer pool memory (CACHE_BYTES), so larger pages mean fewer frames.
+ *
+ * - "full scan": cold cache, every data page read in file order and every
+ *   record visited. Larger pages mean fewer pages (and fewer reads) for
+ *   the same bytes.
+ * - "point lookup": cold cache, random keys looked up in the index and the
+ *   record read from its page. The tree's fanout grows with the page size,
+ *   so fewer levels have to be read per lookup.
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/storage/StorageEngine.hpp>
+#include <learnql/index/PersistentBTreeIndex.hpp>
+#include <cstring>
+#include <memory>
+
+using namespace learnql;
+
+namespace {
+
+constexpr std::size_t NUM_RECORDS = 20000;
+constexpr std::size_t RECORD_SIZE = 128;
+constexpr std::size_t NUM_LOOKUPS = 20000;
+constexpr std::size_t CACHE_BYTES = 2 * 1024 * 1024;
+
+using Index = index::PersistentBTreeIndex<int64_t, core::RecordId>;
+
+struct Layout {
+    std::vector<uint64_t> data_pages;  // In file order
+    uint64_t index_root = 0;
+};
+
+/**
+ * @brief Packs the records into pages and indexes them by key
+ */
+Layout build_database(const std::string& path, std::size_t page_size) {
+    storage::StorageOptions options;
+    options.page_size = page_size;
+    options.cache_size = 1024;
+    auto engine = std::make_shared<storage::StorageEngine>(path, options);
+
+    Layout layout;
+    std::size_t per_page = (page_size - sizeof(storage::PageHeader)) / RECORD_SIZE;
+    std::vector<uint8_t> record(RECORD_SIZE, 0);
+
+    Index index(engine);
+    for (std::size_t first = 0; first < NUM_RECORDS; first += per_page) {
+        auto page = engine->new_page(storage::PageType::DATA);
+        std::size_t count = std::min(per_page, NUM_RECORDS - first);
+        for (std::size_t slot = 0; slot < count; ++slot) {
+            auto key = static_cast<int64_t>(first + slot);
+            std::memcpy(record.data(), &key, sizeof(key));
+            page->write_data(slot * RECORD_SIZE, record.data(), RECORD_SIZE);
+            index.insert(key, core::RecordId{page.page_id(), static_cast<uint32_t>(slot)});
+        }
+        page->header().record_count = static_cast<uint16_t>(count);
+        layout.data_pages.push_back(page.page_id());
+    }
+
+    index.flush();
+    engine->flush_all();
+    layout.index_root = index.get_root_page_id();
+    return layout;
+}
+
+/**
+ * @brief Opens the database with the shared memory budget and an empty cache
+ */
+std::shared_ptr<storage::StorageEngine> open_cold(const std::string& path, std::size_t page_size) {
+    storage::StorageOptions options;
+    options.cache_size = CACHE_BYTES / page_size;
+    return std::make_shared<storage::StorageEngine>(path, options);
+}
+
+} // namespace
+
+int main() {
+    const std::size_t page_sizes[] = {4096, 16384, 65536};
+    auto keys = bench::random_ids(NUM_LOOKUPS, 0, NUM_RECORDS - 1);
+
+    for (std::size_t page_size : page_sizes) {
+        auto path = bench::temp_db_path("learnql_page_size.db");
+        Layout layout = build_database(path, page_size);
+
+        bench::print_header(std::to_string(page_size / 1024) + " KB pages (" +
+                            std::to_string(layout.data_pages.size()) + " data pages, " +
+                            std::to_string(CACHE_BYTES / page_size) + " frames)");
+
+        // Full scan over the data pages
+        {
+            auto engine = open_cold(path, page_size);
+            uint64_t checksum = 0;
+            double seconds = bench::time_seconds([&] {
+                for (uint64_t page_id : layout.data_pages) {
+                    auto page = engine->fetch_page(page_id);
+                    for (std::size_t slot = 0; slot < page->header().record_count; ++slot) {
+                        int64_t key;
+                        page->read_data(slot * RECORD_SIZE, &key, sizeof(key));
+                        checksum += static_cast<uint64_t>(key);
+                    }
+                }
+            });
+            bench::print_row("full scan (records)", NUM_RECORDS, seconds);
+            std::cout << "  " << engine->get_io_stats().pages_read << " pages read (checksum " << checksum << ")\n";
+        }
+
+        // Indexed point lookups
+        {
+            auto engine = open_cold(path, page_size);
+            Index index(engine, layout.index_root);
+            engine->reset_io_stats();
+
+            std::size_t found = 0;
+            double seconds = bench::time_seconds([&] {
+                for (uint64_t key : keys) {
+                    auto rid = index.find(static_cast<int64_t>(key));
+                    if (!rid) {
+                        continue;
+                    }
+                    auto page = engine->fetch_page(rid->page_id);
+                    int64_t stored;
+                    page->read_data(rid->slot * RECORD_SIZE, &stored, sizeof(stored));
+                    found += stored == static_cast<int64_t>(key);
+                }
+            });
+            bench::print_row("point lookup", NUM_LOOKUPS, seconds);
+            std::cout << "  " << found << " found, " << std::fixed << std::setprecision(2)
+                      << static_cast<double>(engine->get_io_stats().pages_read) / NUM_LOOKUPS
+                      << " pages read per lookup\n";
+        }
+    }
+
+    return 0;
+}
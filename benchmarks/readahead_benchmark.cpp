@@ -0,0 +1,168 @@
+/**
+ * @file readahead_benchmark.cpp
+ * @brief Cold scans with different StorageOptions::readahead_pages settings
+ *
+ * Every run starts with the database file dropped from the OS page cache.
+ *
+ * - "page scan": fetch_page() on every allocated page in file order, the
+ *   best case for sequential readahead (ops counts the data pages).
+ * - "table scan": the primary index's batch iterator walks the leaf chain
+ *   and each record's page is fetched, as Table iteration does. Leaves,
+ *   records and catalog pages are interleaved in the file, so part of each
+ *   window is pages the scan never touches; the hit ratio shows how much.
+ *
+ * Each setting runs with the SYNC backend (one vectored read per window)
+ * and with io_uring.
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/LearnQL.hpp>
+#include <fcntl.h>
+#include <memory>
+
+using namespace learnql;
+
+namespace {
+
+constexpr int NUM_RECORDS = 20000;
+constexpr std::size_t CACHE_PAGES = 256;
+
+class Reading {
+    LEARNQL_PROPERTIES_BEGIN(Reading)
+        LEARNQL_PROPERTY(int, id, PK)
+        LEARNQL_PROPERTY(double, value)
+    LEARNQL_PROPERTIES_END(
+        PROP(int, id, PK),
+        PROP(double, value)
+    )
+
+public:
+    Reading() = default;
+    Reading(int id, double value) : id_(id), value_(value) {}
+};
+
+using Index = index::PersistentBTreeIndex<int, core::RecordId>;
+
+/**
+ * @brief Asks the OS to drop a file from its page cache
+ */
+void drop_os_cache(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        ::fdatasync(fd);
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        ::close(fd);
+    }
+}
+
+/**
+ * @brief Builds the table and returns the root page of its primary index
+ */
+uint64_t build_table(const std::string& path) {
+    core::Database db(path, 1024);
+    auto& readings = db.table<Reading>("readings");
+    for (int i = 0; i < NUM_RECORDS; ++i) {
+        readings.insert(Reading(i, i * 0.5));
+    }
+    readings.flush();
+    db.flush();
+    return readings.get_root_page();
+}
+
+std::shared_ptr<storage::StorageEngine> open_cold(const std::string& path, std::size_t readahead,
+                                                  storage::IoBackend backend) {
+    drop_os_cache(path);
+    storage::StorageOptions options;
+    options.cache_size = CACHE_PAGES;
+    options.readahead_pages = readahead;
+    options.io_backend = backend;
+    return std::make_shared<storage::StorageEngine>(path, options);
+}
+
+void print_stats(const storage::IoStats& stats) {
+    std::cout << "  " << stats.pages_read << " pages read, " << stats.readahead_windows << " windows, "
+              << stats.prefetch_hits << " hits / " << stats.prefetch_misses << " unused ("
+              << static_cast<int>(stats.prefetch_hit_ratio() * 100.0) << "% used)\n";
+}
+
+std::string label(const char* scan, std::size_t readahead, const storage::StorageEngine& engine) {
+    return std::string(scan) + " K=" + std::to_string(readahead) + " (" + engine.get_io_backend() + ")";
+}
+
+double run_page_scan(const std::string& path, std::size_t readahead, storage::IoBackend backend) {
+    auto engine = open_cold(path, readahead, backend);
+    uint64_t pages = engine->get_page_count();
+
+    std::size_t scanned = 0;
+    double seconds = bench::time_seconds([&] {
+        for (uint64_t page_id = 1; page_id < pages; ++page_id) {
+            if (engine->is_page_allocated(page_id)) {
+                auto page = engine->fetch_page(page_id);
+                scanned += page->header().page_type == storage::PageType::DATA;
+            }
+        }
+    });
+
+    bench::print_row(label("page scan", readahead, *engine), scanned, seconds);
+    print_stats(engine->get_io_stats());
+    return seconds;
+}
+
+double run_table_scan(const std::string& path, uint64_t root, std::size_t readahead, storage::IoBackend backend) {
+    auto engine = open_cold(path, readahead, backend);
+    Index index(engine, root);
+
+    std::size_t scanned = 0;
+    double seconds = bench::time_seconds([&] {
+        auto iter = index.create_batch_iterator<64>();
+        while (iter.has_more()) {
+            for (const auto& [id, rid] : iter.next_batch()) {
+                auto page = engine->fetch_page(rid.page_id);
+                ++scanned;
+            }
+        }
+    });
+
+    bench::print_row(label("table scan", readahead, *engine), scanned, seconds);
+    print_stats(engine->get_io_stats());
+    return seconds;
+}
+
+} // namespace
+
+int main() {
+    const std::size_t settings[] = {0, 8, 32, 128};
+    const storage::IoBackend backends[] = {storage::IoBackend::SYNC, storage::IoBackend::IO_URING};
+
+    auto path = bench::temp_db_path("learnql_readahead.db");
+    uint64_t root = build_table(path);
+
+    for (auto backend : backends) {
+        bench::print_header(std::string("Cold page scan, ") + (backend == storage::IoBackend::SYNC ? "sync" : "io_uring"));
+        double baseline = 0.0;
+        for (std::size_t readahead : settings) {
+            double seconds = run_page_scan(path, readahead, backend);
+            if (readahead == 0) {
+                baseline = seconds;
+            } else {
+                bench::print_speedup("  speedup over K=0", baseline, seconds);
+            }
+        }
+    }
+
+    for (auto backend : backends) {
+        bench::print_header(std::string("Cold table scan (") + std::to_string(NUM_RECORDS) + " records), " +
+                            (backend == storage::IoBackend::SYNC ? "sync" : "io_uring"));
+        double baseline = 0.0;
+        for (std::size_t readahead : settings) {
+            double seconds = run_table_scan(path, root, readahead, backend);
+            if (readahead == 0) {
+                baseline = seconds;
+            } else {
+                bench::print_speedup("  speedup over K=0", baseline, seconds);
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file scan_resistance_benchmark.cpp
+ * @brief Point lookups running alongside table scans, CLOCK vs. 2Q replacement
+ *
+ * A small "customers" table fits in the buffer pool and gets point lookups
+ * by primary key. Interleaved with them (every lookup advances the scan by
+ * SCAN_STEP records), full scans of a large "orders" table pull thousands
+ * of pages through the same pool.
+ *
+ * - ReplacementPolicy::CLOCK: every scanned page gets a reference bit like
+ *   the customers' pages, so each pass of the scan sweeps them out and the
+ *   lookups keep going to disk
+ * - ReplacementPolicy::TWO_Q: scanned pages stay on probation and recycle
+ *   among themselves; the customers' pages (and index nodes) are protected
+ *
+ * The database uses direct I/O so that the buffer pool is the only cache
+ * (where the file system supports it): a lookup miss is a real read.
+ * "lookup pages read" counts the pages read by lookups alone.
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/LearnQL.hpp>
+
+using namespace learnql;
+
+namespace {
+
+constexpr int NUM_CUSTOMERS = 600;
+constexpr int NUM_ORDERS = 20000;
+constexpr std::size_t NUM_LOOKUPS = 40000;
+constexpr std::size_t SCAN_STEP = 2;
+constexpr std::size_t CACHE_PAGES = 1024;
+
+class Customer {
+    LEARNQL_PROPERTIES_BEGIN(Customer)
+        LEARNQL_PROPERTY(int, id, PK)
+        LEARNQL_PROPERTY(std::string, name)
+    LEARNQL_PROPERTIES_END(
+        PROP(int, id, PK),
+        PROP(std::string, name)
+    )
+
+public:
+    Customer() = default;
+    Customer(int id, std::string name) : id_(id), name_(std::move(name)) {}
+};
+
+class Order {
+    LEARNQL_PROPERTIES_BEGIN(Order)
+        LEARNQL_PROPERTY(int, id, PK)
+        LEARNQL_PROPERTY(int, customer_id)
+        LEARNQL_PROPERTY(double, amount)
+    LEARNQL_PROPERTIES_END(
+        PROP(int, id, PK),
+        PROP(int, customer_id),
+        PROP(double, amount)
+    )
+
+public:
+    Order() = default;
+    Order(int id, int customer_id, double amount) : id_(id), customer_id_(customer_id), amount_(amount) {}
+};
+
+storage::StorageOptions options_for(storage::ReplacementPolicy policy) {
+    storage::StorageOptions options;
+    options.cache_size = CACHE_PAGES;
+    options.replacement = policy;
+    options.direct_io = true;
+    return options;
+}
+
+void run(const std::string& path, storage::ReplacementPolicy policy) {
+    core::Database db(path, options_for(policy));
+    auto& customers = db.table<Customer>("customers");
+    for (int i = 0; i < NUM_CUSTOMERS; ++i) {
+        customers.insert(Customer(i, "Customer #" + std::to_string(i)));
+    }
+    auto& orders = db.table<Order>("orders");
+    for (int i = 0; i < NUM_ORDERS; ++i) {
+        orders.insert(Order(i, i % NUM_CUSTOMERS, i * 0.5));
+    }
+    customers.flush();
+    orders.flush();
+    db.flush();
+
+    auto& engine = db.get_storage();
+    engine.clear_cache();
+    auto keys = bench::random_ids(NUM_LOOKUPS, 0, NUM_CUSTOMERS - 1, 11);
+
+    // Warm up: every customer twice (a working set), then the scan starts
+    for (int i = 0; i < 2 * NUM_CUSTOMERS; ++i) {
+        auto customer = customers.find(i % NUM_CUSTOMERS);
+    }
+    engine.reset_io_stats();
+
+    uint64_t lookup_reads = 0;
+    std::size_t scanned = 0;
+    std::size_t found = 0;
+    auto scan = orders.begin();
+    double seconds = bench::time_seconds([&] {
+        for (uint64_t key : keys) {
+            uint64_t before = engine.get_io_stats().pages_read;
+            found += customers.find(static_cast<int>(key)) ? 1 : 0;
+            lookup_reads += engine.get_io_stats().pages_read - before;
+
+            for (std::size_t step = 0; step < SCAN_STEP; ++step) {
+                if (scan == orders.end()) {
+                    scan = orders.begin();
+                }
+                ++scan;
+                ++scanned;
+            }
+        }
+    });
+    if (found != NUM_LOOKUPS) {
+        std::cout << "  (" << NUM_LOOKUPS - found << " keys not found)\n";
+    }
+
+    std::string mode = policy == storage::ReplacementPolicy::CLOCK ? " (CLOCK)" : " (2Q)";
+    bench::print_row("lookups + scan" + mode, NUM_LOOKUPS, seconds);
+    auto stats = engine.get_io_stats();
+    std::cout << "  lookup pages read: " << lookup_reads << ", all pages read: " << stats.pages_read
+              << ", hit ratio " << std::fixed << std::setprecision(1) << stats.hit_ratio() * 100.0 << "%, "
+              << scanned << " orders scanned\n";
+}
+
+} // namespace
+
+int main() {
+    bench::print_header(std::to_string(NUM_LOOKUPS) + " customer lookups, " + std::to_string(SCAN_STEP) +
+                        " orders scanned per lookup, " + std::to_string(CACHE_PAGES) + " cached pages");
+    run(bench::temp_db_path("learnql_scan_resistance_clock.db"), storage::ReplacementPolicy::CLOCK);
+    run(bench::temp_db_path("learnql_scan_resistance_2q.db"), storage::ReplacementPolicy::TWO_Q);
+    return 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file slotted_page_benchmark.cpp
+ * @brief File size and scan I/O of a table of small records
+ *
+ * Inserts NUM_RECORDS records of about 40 bytes, then scans the table with
+ * a cold buffer pool. With slotted pages the records share data pages, so
+ * the file and the pages read per scan shrink by the number of records per
+ * page (one page per record was the old layout; "one page per record" shows
+ * the data pages it would take).
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/LearnQL.hpp>
+#include <unordered_set>
+
+using namespace learnql;
+
+namespace {
+
+constexpr int NUM_RECORDS = 20000;
+
+class Reading {
+    LEARNQL_PROPERTIES_BEGIN(Reading)
+        LEARNQL_PROPERTY(int, id, PK)
+        LEARNQL_PROPERTY(std::string, sensor)
+        LEARNQL_PROPERTY(double, value)
+    LEARNQL_PROPERTIES_END(
+        PROP(int, id, PK),
+        PROP(std::string, sensor),
+        PROP(double, value)
+    )
+
+public:
+    Reading() = default;
+    Reading(int id, std::string sensor, double value) : id_(id), sensor_(std::move(sensor)), value_(value) {}
+};
+
+} // namespace
+
+int main() {
+    auto path = bench::temp_db_path("learnql_slotted_page.db");
+    core::Database db(path);
+    auto& readings = db.table<Reading>("readings");
+
+    bench::print_header(std::to_string(NUM_RECORDS) + " records of ~40 bytes");
+    double seconds = bench::time_seconds([&] {
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            readings.insert(Reading(i, "sensor-" + std::to_string(i % 100), i * 0.25));
+        }
+        readings.flush();
+        db.flush();
+    });
+    bench::print_row("insert", NUM_RECORDS, seconds);
+
+    std::unordered_set<uint64_t> data_pages;
+    for (int i = 0; i < NUM_RECORDS; ++i) {
+        data_pages.insert(readings.get_record_id(i)->page_id);
+    }
+    std::cout << "  data pages: " << data_pages.size() << " (one page per record: " << NUM_RECORDS << "), "
+              << std::fixed << std::setprecision(1)
+              << static_cast<double>(NUM_RECORDS) / data_pages.size() << " records per page\n";
+    std::cout << "  file size: " << std::filesystem::file_size(path) / 1024 << " KB\n";
+
+    auto& engine = db.get_storage();
+    engine.clear_cache();
+    engine.reset_io_stats();
+    std::size_t scanned = 0;
+    seconds = bench::time_seconds([&] {
+        for (const auto& reading : readings) {
+            scanned += reading.get_id() >= 0 ? 1 : 0;
+        }
+    });
+    bench::print_row("cold full scan", scanned, seconds);
+    std::cout << "  pages read by the scan: " << engine.get_io_stats().pages_read << "\n";
+    return 0;
+}
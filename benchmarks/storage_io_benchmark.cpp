@@ -0,0 +1,95 @@
+/**
+ * @file storage_io_benchmark.cpp
+ * @brief Miss-heavy point lookups: reopen-per-read vs. persistent descriptor
+ *
+ * Builds a database of NUM_PAGES pages, then performs random page reads with
+ * a cache far smaller than the file so nearly every read misses.
+ *
+ * - "ifstream per read" reproduces the old read path: construct an
+ *   std::ifstream, seek, read 4KB, destroy (open/close on every miss).
+ * - "StorageEngine::read_page" uses the engine's persistent descriptor
+ *   and a single pread per miss.
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/storage/StorageEngine.hpp>
+#include <fstream>
+
+using namespace learnql;
+
+namespace {
+
+constexpr std::size_t NUM_PAGES = 16384;   // 64 MB database
+constexpr std::size_t NUM_LOOKUPS = 200000;
+constexpr std::size_t CACHE_PAGES = 16;
+
+void build_database(const std::string& path) {
+    storage::StorageEngine engine(path, 1024);
+    for (std::size_t i = 0; i < NUM_PAGES; ++i) {
+        uint64_t page_id = engine.allocate_page(storage::PageType::DATA);
+        auto page = engine.read_page(page_id);
+        page.write_data(0, &page_id, sizeof(page_id));
+        engine.write_page(page_id, page);
+    }
+    engine.flush_all();
+}
+
+/**
+ * @brief The pre-change read path: one std::ifstream per cache miss
+ */
+storage::Page legacy_read_page(const std::string& path, uint64_t page_id) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Cannot open file for reading: " + path);
+    }
+    file.seekg(static_cast<std::streamoff>(page_id * storage::PAGE_SIZE));
+    storage::Page page;
+    file.read(static_cast<char*>(page.raw_data()), storage::PAGE_SIZE);
+    if (!file || !page.header().is_valid()) {
+        throw std::runtime_error("Cannot read page " + std::to_string(page_id));
+    }
+    return page;
+}
+
+} // namespace
+
+int main() {
+    auto path = bench::temp_db_path("learnql_storage_io.db");
+    build_database(path);
+
+    auto ids = bench::random_ids(NUM_LOOKUPS, 1, NUM_PAGES);
+    uint64_t checksum_legacy = 0;
+    uint64_t checksum_engine = 0;
+
+    bench::print_header("Miss-heavy point lookups (" + std::to_string(NUM_PAGES) +
+                        " pages, cache " + std::to_string(CACHE_PAGES) + " pages)");
+
+    double legacy_seconds = bench::time_seconds([&] {
+        for (uint64_t id : ids) {
+            auto page = legacy_read_page(path, id);
+            uint64_t stored = 0;
+            page.read_data(0, &stored, sizeof(stored));
+            checksum_legacy += stored;
+        }
+    });
+    bench::print_row("ifstream per read (before)", ids.size(), legacy_seconds);
+
+    storage::StorageEngine engine(path, CACHE_PAGES);
+    double engine_seconds = bench::time_seconds([&] {
+        for (uint64_t id : ids) {
+            auto page = engine.read_page(id);
+            uint64_t stored = 0;
+            page.read_data(0, &stored, sizeof(stored));
+            checksum_engine += stored;
+        }
+    });
+    bench::print_row("StorageEngine::read_page (after)", ids.size(), engine_seconds);
+
+    if (checksum_legacy != checksum_engine) {
+        std::cerr << "Mismatch between read paths!\n";
+        return 1;
+    }
+
+    bench::print_speedup("Speedup", legacy_seconds, engine_seconds);
+    return 0;
+}
@@ -0,0 +1,88 @@
+/**
+ * @file update_forwarding_benchmark.cpp
+ * @brief Growing updates on a table with secondary indexes
+ *
+ * Records start small and packed into shared pages, then every record
+ * grows past what its page can hold. Two ways to apply the growth:
+ *
+ * - update(): the record moves to another page and its home slot keeps a
+ *   forwarding stub, so the RecordId and every index entry stay as they are
+ * - remove() + insert(): the record gets a new RecordId, so the primary
+ *   index and all secondary indexes are rewritten (what moving a record
+ *   costs without forwarding)
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/LearnQL.hpp>
+
+using namespace learnql;
+
+namespace {
+
+constexpr int NUM_RECORDS = 5000;
+constexpr std::size_t GROWN_BYTES = 600;
+
+class Account {
+    LEARNQL_PROPERTIES_BEGIN(Account)
+        LEARNQL_PROPERTY(int, id, PK)
+        LEARNQL_PROPERTY(std::string, email)
+        LEARNQL_PROPERTY(int, region)
+        LEARNQL_PROPERTY(int, tier)
+        LEARNQL_PROPERTY(std::string, notes)
+    LEARNQL_PROPERTIES_END(
+        PROP(int, id, PK),
+        PROP(std::string, email),
+        PROP(int, region),
+        PROP(int, tier),
+        PROP(std::string, notes)
+    )
+
+public:
+    Account() = default;
+    Account(int id, std::string notes)
+        : id_(id),
+          email_("user" + std::to_string(id) + "@example.com"),
+          region_(id % 20),
+          tier_(id % 3),
+          notes_(std::move(notes)) {}
+};
+
+void run(const std::string& path, bool forwarding) {
+    core::Database db(path);
+    auto& accounts = db.table<Account>("accounts")
+        .add_index(Account::email, core::IndexType::Unique)
+        .add_index(Account::region, core::IndexType::MultiValue)
+        .add_index(Account::tier, core::IndexType::MultiValue);
+    for (int i = 0; i < NUM_RECORDS; ++i) {
+        accounts.insert(Account(i, "new"));
+    }
+    accounts.flush();
+
+    auto& engine = db.get_storage();
+    engine.reset_io_stats();
+    double seconds = bench::time_seconds([&] {
+        for (int i = 0; i < NUM_RECORDS; ++i) {
+            Account grown(i, std::string(GROWN_BYTES, 'n'));
+            if (forwarding) {
+                accounts.update(grown);
+            } else {
+                accounts.remove(i);
+                accounts.insert(grown);
+            }
+        }
+        accounts.flush();
+    });
+
+    bench::print_row(forwarding ? "update (forwarding stub)" : "remove + insert (new RecordId)", NUM_RECORDS, seconds);
+    std::cout << "  pages written: " << engine.get_io_stats().pages_written << "\n";
+}
+
+} // namespace
+
+int main() {
+    bench::print_header(std::to_string(NUM_RECORDS) + " records grown to " + std::to_string(GROWN_BYTES) +
+                        " bytes, 3 secondary indexes");
+    run(bench::temp_db_path("learnql_update_rewrite.db"), false);
+    run(bench::temp_db_path("learnql_update_forwarding.db"), true);
+    return 0;
+}
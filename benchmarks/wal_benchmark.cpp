@@ -0,0 +1,119 @@
+/**
+ * @file wal_benchmark.cpp
+ * @brief Durable random updates: in-place flush vs. write-ahead log commit
+ *
+ * Each transaction rewrites PAGES_PER_TXN random pages of a NUM_PAGES
+ * database and then makes the change durable with StorageEngine::commit().
+ *
+ * - "in-place flush" (WAL disabled): every dirty page is written to its own
+ *   slot in the file and the file is synced - random writes per commit.
+ * - "write-ahead log": the page images are appended to the log and the log
+ *   is synced once; pages reach the file at checkpoints.
+ *
+ * A second section drives WriteAheadLog directly from several threads to
+ * show group commit: concurrent commits share one fsync.
+ */
+
+#include "BenchCommon.hpp"
+#include <learnql/storage/StorageEngine.hpp>
+#include <learnql/storage/WriteAheadLog.hpp>
+#include <thread>
+
+using namespace learnql;
+
+namespace {
+
+constexpr std::size_t NUM_PAGES = 8192;    // 32 MB database
+constexpr std::size_t NUM_TXNS = 400;
+constexpr std::size_t PAGES_PER_TXN = 8;
+constexpr std::size_t CACHE_PAGES = 2 * NUM_PAGES;  // No evictions: isolate commit cost
+
+constexpr std::size_t GROUP_THREADS = 8;
+constexpr std::size_t GROUP_COMMITS_PER_THREAD = 250;
+
+void build_database(const std::string& path) {
+    storage::StorageEngine engine(path, CACHE_PAGES);
+    for (std::size_t i = 0; i < NUM_PAGES; ++i) {
+        auto page = engine.new_page(storage::PageType::DATA);
+        uint64_t page_id = page.page_id();
+        page->write_data(0, &page_id, sizeof(page_id));
+    }
+}
+
+double run_updates(const std::string& path, bool enable_wal, storage::IoStats& stats) {
+    storage::StorageOptions options;
+    options.cache_size = CACHE_PAGES;
+    options.enable_wal = enable_wal;
+    storage::StorageEngine engine(path, options);
+    engine.reset_io_stats();
+
+    auto ids = bench::random_ids(NUM_TXNS * PAGES_PER_TXN, 1, NUM_PAGES);
+    double seconds = bench::time_seconds([&] {
+        for (std::size_t txn = 0; txn < NUM_TXNS; ++txn) {
+            for (std::size_t i = 0; i < PAGES_PER_TXN; ++i) {
+                auto page = engine.fetch_page_mut(ids[txn * PAGES_PER_TXN + i]);
+                uint64_t value = txn;
+                page->write_data(8, &value, sizeof(value));
+            }
+            engine.commit();
+        }
+    });
+
+    stats = engine.get_io_stats();
+    return seconds;
+}
+
+} // namespace
+
+int main() {
+    auto path = bench::temp_db_path("learnql_wal.db");
+    build_database(path);
+
+    bench::print_header("Durable random updates (" + std::to_string(NUM_TXNS) + " commits x " +
+                        std::to_string(PAGES_PER_TXN) + " pages, " + std::to_string(NUM_PAGES) + " page file)");
+
+    storage::IoStats in_place_stats;
+    double in_place_seconds = run_updates(path, false, in_place_stats);
+    bench::print_row("in-place flush + fsync (no WAL)", NUM_TXNS, in_place_seconds);
+
+    storage::IoStats wal_stats;
+    double wal_seconds = run_updates(path, true, wal_stats);
+    bench::print_row("write-ahead log commit", NUM_TXNS, wal_seconds);
+
+    std::cout << "  in-place: " << in_place_stats.pages_written << " page writes in "
+              << in_place_stats.flush_runs << " runs\n";
+    std::cout << "  WAL:      " << wal_stats.wal_records << " log records, "
+              << wal_stats.wal_syncs << " log syncs, " << wal_stats.pages_written << " page writes\n";
+    bench::print_speedup("Speedup", in_place_seconds, wal_seconds);
+
+    // Group commit: many threads appending and flushing concurrently
+    bench::print_header("Group commit (" + std::to_string(GROUP_THREADS) + " threads)");
+
+    auto wal_path = bench::temp_db_path("learnql_group_commit.wal");
+    storage::WriteAheadLog wal(wal_path, 1);
+    storage::Page image(1, storage::PageType::DATA);
+
+    double group_seconds = bench::time_seconds([&] {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < GROUP_THREADS; ++t) {
+            threads.emplace_back([&, t] {
+                for (std::size_t i = 0; i < GROUP_COMMITS_PER_THREAD; ++i) {
+                    wal.append(storage::WalRecordType::PAGE_IMAGE, t, image.raw_data(), storage::PAGE_SIZE);
+                    wal.flush();
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    std::size_t total_commits = GROUP_THREADS * GROUP_COMMITS_PER_THREAD;
+    bench::print_row("concurrent commits", total_commits, group_seconds);
+    std::cout << "  " << total_commits << " commits, " << wal.sync_count() << " fsyncs ("
+              << std::fixed << std::setprecision(1)
+              << static_cast<double>(total_commits) / static_cast<double>(wal.sync_count())
+              << " commits per sync)\n";
+
+    return 0;
+}
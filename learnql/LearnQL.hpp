@@ -58,6 +58,8 @@
 // ============================================================================
 
 #include "storage/Page.hpp"
+#include "storage/SlottedPage.hpp"
+#include "storage/OverflowChain.hpp"
 #include "storage/StorageEngine.hpp"
 
 // ============================================================================
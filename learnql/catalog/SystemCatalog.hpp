@@ -11,6 +11,8 @@
 #include <vector>
 #include <stdexcept>
 #include <chrono>
+#include <string>
+#include <unordered_map>
 
 namespace learnql {
     // Forward declarations
@@ -76,7 +78,8 @@ public:
         fields_table_(storage, "_sys_fields", sys_fields_root),
         indexes_table_(storage, "_sys_indexes", sys_indexes_root),
         next_field_id_(1),  // Temporary value, updated in constructor body
-        next_index_id_(1)   // Temporary value, updated in constructor body
+        next_index_id_(1),  // Temporary value, updated in constructor body
+        pending_counts_()
     {
         // Compute next field ID after fields_table_ is constructed
         next_field_id_ = compute_next_field_id();
@@ -175,6 +178,8 @@ private:
      * Removes table metadata and all associated field metadata.
      */
     void unregister_table(const std::string& table_name) {
+        pending_counts_.erase(table_name);
+
         // Remove table metadata
         tables_table_.internal_table().remove(table_name);
 
@@ -193,17 +198,30 @@ private:
      * @brief Update record count for a table
      * @param table_name Name of table
      * @param count New record count
+     * @details Only remembered here; _sys_tables is rewritten by
+     *          write_record_counts() (at flush()), so inserts and removes
+     *          do not pay for a catalog lookup and update each.
      */
     void update_record_count(const std::string& table_name, std::size_t count) {
-        auto meta_opt = tables_table_.internal_table().find(table_name);
-        if (!meta_opt) {
-            // Table not in catalog - might be system table during bootstrap
-            return;
-        }
+        pending_counts_[table_name] = count;
+    }
+
+    /**
+     * @brief Writes the record counts given to update_record_count() to _sys_tables
+     */
+    void write_record_counts() {
+        for (const auto& [table_name, count] : pending_counts_) {
+            auto meta_opt = tables_table_.internal_table().find(table_name);
+            if (!meta_opt || meta_opt->record_count == count) {
+                // Not in catalog (system table during bootstrap) or unchanged
+                continue;
+            }
 
-        auto meta = *meta_opt;
-        meta.record_count = count;
-        tables_table_.internal_table().update(meta);
+            auto meta = *meta_opt;
+            meta.record_count = count;
+            tables_table_.internal_table().update(meta);
+        }
+        pending_counts_.clear();
     }
 
     // ===== Secondary Index Management (NEW!) =====
@@ -286,6 +304,17 @@ private:
         return result;
     }
 
+    /**
+     * @brief Writes pending record counts, then the catalog tables' dirty
+     *        index nodes, to storage
+     */
+    void flush() {
+        write_record_counts();
+        tables_table_.internal_table().flush();
+        fields_table_.internal_table().flush();
+        indexes_table_.internal_table().flush();
+    }
+
     /**
      * @brief Get root page ID for tables table
      */
@@ -357,6 +386,7 @@ private:
     core::ReadOnlyTable<IndexMetadata> indexes_table_;  // NEW!
     uint64_t next_field_id_;   // Auto-increment for field IDs
     uint64_t next_index_id_;   // Auto-increment for index IDs
+    std::unordered_map<std::string, std::size_t> pending_counts_;  // Record counts not yet in _sys_tables
 };
 
 } // namespace learnql::catalog
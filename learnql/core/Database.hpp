@@ -7,6 +7,7 @@
 #include "../catalog/TableMetadata.hpp"
 #include "../catalog/FieldMetadata.hpp"
 #include "../reflection/FieldExtractor.hpp"
+#include "../debug/Statistics.hpp"
 #include <unordered_map>
 #include <memory>
 #include <typeindex>
@@ -51,7 +52,44 @@ public:
         : storage_(std::make_shared<storage::StorageEngine>(file_path, cache_size)),
           tables_{},
           table_names_{},
-          catalog_{nullptr} {
+          catalog_{nullptr},
+          memory_governor_{nullptr} {
+
+        // Initialize system catalog
+        initialize_system_catalog();
+    }
+
+    /**
+     * @brief Opens a database with explicit storage options
+     * @param file_path Path to the database file
+     * @param options Storage settings (e.g. read-only memory-mapped access)
+     * @throws std::runtime_error if database cannot be opened
+     *
+     * Example:
+     * @code
+     * storage::StorageOptions options;
+     * options.read_only = true;
+     * options.memory_map = true;
+     * Database db("school.db", options);   // Several processes can do this at once
+     * @endcode
+     *
+     * With options.memory_budget_bytes set, the database owns a
+     * MemoryGovernor that sizes the buffer pool and every index's node
+     * cache from that one budget (see get_memory_governor()).
+     */
+    Database(const std::string& file_path, const storage::StorageOptions& options)
+        : storage_(std::make_shared<storage::StorageEngine>(file_path, options)),
+          tables_{},
+          table_names_{},
+          catalog_{nullptr},
+          memory_governor_{nullptr} {
+
+        // Before any index exists, so every node cache registers with it
+        if (options.memory_budget_bytes > 0) {
+            memory_governor_ = std::make_shared<storage::MemoryGovernor>(options.memory_budget_bytes,
+                                                                         options.query_memory_fraction);
+            storage_->set_memory_governor(memory_governor_);
+        }
 
         // Initialize system catalog
         initialize_system_catalog();
@@ -196,9 +234,18 @@ public:
 
     /**
      * @brief Flushes all tables to disk
+     * @details Catalog root pages can move when their B+trees split, so the
+     *          current roots are handed to the storage engine, which persists
+     *          them in page 0 after the data pages.
      */
     void flush() {
         if (storage_) {
+            if (catalog_) {
+                catalog_->flush();
+                storage_->set_sys_tables_root(catalog_->get_tables_root_page());
+                storage_->set_sys_fields_root(catalog_->get_fields_root_page());
+                storage_->set_sys_indexes_root(catalog_->get_indexes_root_page());
+            }
             storage_->flush_all();
         }
     }
@@ -226,6 +273,27 @@ public:
         return *storage_;
     }
 
+    /**
+     * @brief Records the storage engine's counters with the statistics collector
+     * @details Takes a snapshot of StorageEngine::get_io_stats() (buffer
+     *          pool hits and misses, evictions, bytes read and written,
+     *          flush times) so it shows up in print_all().
+     *
+     * Example:
+     * @code
+     * db.record_statistics();
+     * debug::StatisticsCollector::instance().print_all();
+     * @endcode
+     */
+    void record_statistics() const {
+        debug::StatisticsCollector::instance().record_storage(debug::StorageStatistics{
+            .database = storage_->get_file_path(),
+            .page_size = storage_->get_page_size(),
+            .cache_size = storage_->get_cache_size(),
+            .io = storage_->get_io_stats(),
+        });
+    }
+
     /**
      * @brief Gets the storage engine as a shared pointer
      * @return Shared pointer to the storage engine
@@ -246,6 +314,22 @@ public:
         return storage_;
     }
 
+    /**
+     * @brief Gets the memory governor
+     * @return The governor sharing StorageOptions::memory_budget_bytes
+     *         between the caches, or nullptr if none was configured
+     *
+     * Example:
+     * @code
+     * for (const auto& share : db.get_memory_governor()->shares()) {
+     *     std::cout << share.name << ": " << share.limit_bytes << " bytes\n";
+     * }
+     * @endcode
+     */
+    [[nodiscard]] std::shared_ptr<storage::MemoryGovernor> get_memory_governor() const noexcept {
+        return memory_governor_;
+    }
+
     /**
      * @brief Gets the database file path
      */
@@ -317,6 +401,8 @@ public:
     /**
      * @brief Gets the system catalog for querying metadata
      * @return Reference to the system catalog
+     * @details Record counts are kept in memory between flushes; they are
+     *          written to the catalog first so queries see current counts.
      *
      * Example:
      * @code
@@ -329,6 +415,7 @@ public:
         if (!catalog_) {
             throw std::runtime_error("System catalog not initialized");
         }
+        catalog_->write_record_counts();
         return *catalog_;
     }
 
@@ -339,6 +426,7 @@ public:
         if (!catalog_) {
             throw std::runtime_error("System catalog not initialized");
         }
+        catalog_->write_record_counts();
         return *catalog_;
     }
 
@@ -485,6 +573,7 @@ private:
     std::unordered_map<std::size_t, std::shared_ptr<void>> named_tables_;    ///< Named tables (hash-based)
     std::unordered_map<std::size_t, std::string> named_table_names_;         ///< Named table names
     std::unique_ptr<catalog::SystemCatalog> catalog_;                         ///< System catalog for metadata
+    std::shared_ptr<storage::MemoryGovernor> memory_governor_;                ///< Shared memory budget (null if unset)
 };
 
 } // namespace learnql::core
@@ -4,6 +4,9 @@
 #include "RecordId.hpp"
 #include "../concepts/Queryable.hpp"
 #include "../storage/StorageEngine.hpp"
+#include "../storage/SlottedPage.hpp"
+#include "../storage/OverflowChain.hpp"
+#include "../storage/PageSpaceTracker.hpp"
 #include "../serialization/BinaryWriter.hpp"
 #include "../serialization/BinaryReader.hpp"
 #include "../ranges/QueryView.hpp"
@@ -17,6 +20,11 @@
 #include <stdexcept>
 #include <algorithm>
 #include <functional>
+#include <span>
+#include <array>
+#include <optional>
+#include <unordered_set>
+#include <ranges>
 
 namespace learnql {
     // Forward declarations
@@ -49,6 +57,8 @@ enum class IndexType {
  * - Integration with storage engine
  * - Lazy batch loading (records loaded in configurable batches)
  * - Memory-efficient traversal
+ * - Many records per page (slotted pages, see storage::SlottedPage)
+ * - Records larger than a page (overflow chains, see storage::OverflowChain)
  *
  * Example:
  * @code
@@ -210,7 +220,8 @@ public:
           table_name_(std::move(table_name)),
           index_(nullptr),
           count_(0),
-          catalog_(nullptr) {
+          catalog_(nullptr),
+          page_space_() {
         // Create or load index
         index_ = std::make_unique<index_type>(storage_, root_page_id);
 
@@ -249,22 +260,10 @@ public:
         writer.write(record);
         auto data = writer.get_buffer();
 
-        // Allocate a page if needed
-        uint64_t page_id = storage_->allocate_page(storage::PageType::DATA);
-
-        // Write to page
-        auto page = storage_->read_page(page_id);
-        if (!page.can_fit(data.size())) {
-            throw std::runtime_error("Record too large for single page");
-        }
-
-        page.write_data(0, data.data(), data.size());
-        page.header().record_count = 1;
-        page.header().free_space_offset = sizeof(storage::PageHeader) + data.size();
-        storage_->write_page(page_id, page);
+        // Write into a page with room for it
+        RecordId rid = store_record(data);
 
         // Update primary index
-        RecordId rid{page_id, 0};
         index_->insert(key, rid);
 
         // Update all secondary indexes
@@ -278,10 +277,116 @@ public:
         sync_catalog_count();
     }
 
+    /**
+     * @brief Inserts many records at once
+     * @param records Records to insert, in any order
+     * @return Number of records inserted
+     * @throws std::runtime_error if a primary key repeats within the batch
+     *         or already exists in the table (nothing is inserted then)
+     * @details Cheaper per record than insert(): the records are written in
+     *          primary key order into pages filled one after another, the
+     *          primary and secondary indexes take their entries as sorted
+     *          batches (bulk-built when the batch outgrows them, see
+     *          PersistentBTreeIndex::insert_sorted), and the catalog's
+     *          record count is updated once.
+     */
+    std::size_t insert_batch(std::span<const T> records) {
+        if (records.empty()) {
+            return 0;
+        }
+
+        // Primary key order, checked for duplicates before anything is written
+        std::vector<std::pair<primary_key_type, std::size_t>> keys;
+        keys.reserve(records.size());
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            keys.emplace_back(records[i].get_primary_key(), i);
+        }
+        std::sort(keys.begin(), keys.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        for (std::size_t i = 0; i < keys.size(); ++i) {
+            if ((i > 0 && keys[i - 1].first == keys[i].first) ||
+                (!index_->empty() && index_->contains(keys[i].first))) {
+                throw std::runtime_error("Record with primary key already exists");
+            }
+        }
+
+        // Fill pages sequentially, starting a new one when a record does not fit
+        std::vector<std::pair<primary_key_type, RecordId>> entries;
+        std::vector<std::pair<const T*, RecordId>> placed;
+        entries.reserve(records.size());
+        placed.reserve(records.size());
+        serialization::BinaryWriter writer;
+        storage::PageGuard page;
+        for (auto& [key, i] : keys) {
+            writer.clear();
+            writer.write(records[i]);
+            std::span<const uint8_t> bytes = writer.get_buffer();
+            std::array<uint8_t, storage::OverflowHead::SIZE> head{};
+            uint16_t flags = 0;
+            if (needs_overflow(bytes.size())) {
+                head = storage::OverflowChain::write(*storage_, bytes).encode();
+                bytes = head;
+                flags = storage::SlottedPage::SLOT_OVERFLOW;
+            }
+
+            std::optional<uint32_t> slot;
+            if (page) {
+                slot = storage::SlottedPage(*page).insert(bytes, flags);
+            }
+            if (!slot) {
+                if (page) {
+                    page_space_.update(page.page_id(), storage::SlottedPage::free_space(*page));
+                }
+                page = storage_->new_page(storage::PageType::DATA);
+                slot = storage::SlottedPage(*page).insert(bytes, flags);
+            }
+
+            RecordId rid{page.page_id(), *slot};
+            entries.emplace_back(std::move(key), rid);
+            placed.emplace_back(&records[i], rid);
+        }
+        page_space_.update(page.page_id(), storage::SlottedPage::free_space(*page));
+        page.release();
+
+        index_->insert_sorted(entries);
+        for (auto& sec_idx : secondary_indexes_) {
+            sec_idx->insert_records(placed);
+        }
+
+        count_ += records.size();
+        sync_catalog_count();
+        return records.size();
+    }
+
+    /**
+     * @brief Inserts every record of a range at once (see insert_batch())
+     * @param records Range of records
+     * @return Number of records inserted
+     * @throws std::runtime_error as insert_batch()
+     */
+    template<std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, const T&>
+    std::size_t insert_range(R&& records) {
+        if constexpr (std::ranges::contiguous_range<R> &&
+                      std::same_as<std::ranges::range_value_t<R>, T>) {
+            return insert_batch(std::span<const T>(std::ranges::data(records), std::ranges::size(records)));
+        } else {
+            std::vector<T> copy;
+            for (auto&& record : records) {
+                copy.push_back(record);
+            }
+            return insert_batch(copy);
+        }
+    }
+
     /**
      * @brief Updates an existing record
      * @param record Record with updated data
      * @throws std::runtime_error if record not found
+     * @details The record is rewritten in its slot when its page has room.
+     *          Otherwise it moves to another page and its home slot keeps a
+     *          forwarding stub, so the record keeps its RecordId and only
+     *          secondary index entries whose field value changed are touched.
      */
     void update(const T& record) {
         auto key = record.get_primary_key();
@@ -299,21 +404,33 @@ public:
         writer.write(record);
         auto data = writer.get_buffer();
 
-        // Read the page
-        auto page = storage_->read_page(rid_opt->page_id);
-
-        // Check if it fits (simple implementation - no page splitting yet)
-        if (!page.can_fit(data.size())) {
-            throw std::runtime_error("Updated record too large");
+        // A record too large for a page goes to a new overflow chain first
+        std::span<const uint8_t> slot_bytes = data;
+        uint16_t slot_flags = 0;
+        std::array<uint8_t, storage::OverflowHead::SIZE> head;
+        if (needs_overflow(data.size())) {
+            head = storage::OverflowChain::write(*storage_, data).encode();
+            slot_bytes = head;
+            slot_flags = storage::SlottedPage::SLOT_OVERFLOW;
         }
 
-        // Write updated data
-        page.write_data(0, data.data(), data.size());
-        storage_->write_page(rid_opt->page_id, page);
+        if (rewrite_record(*rid_opt, slot_bytes, slot_flags)) {
+            // Same RecordId: only changed field values move in the secondary indexes
+            for (auto& sec_idx : secondary_indexes_) {
+                sec_idx->update_record(old_record, record, *rid_opt);
+            }
+            return;
+        }
 
-        // Update all secondary indexes
+        // Not even a stub fits the home page (a tiny record in a full page):
+        // move the record, then repoint every index at it
+        RecordId new_rid = place_record(slot_bytes, slot_flags);
+        erase_record(*rid_opt);
+        index_->remove(key);
+        index_->insert(key, new_rid);
         for (auto& sec_idx : secondary_indexes_) {
-            sec_idx->update_record(old_record, record, *rid_opt);
+            sec_idx->remove_record(old_record, *rid_opt);
+            sec_idx->insert_record(record, new_rid);
         }
     }
 
@@ -336,8 +453,8 @@ public:
             sec_idx->remove_record(record, *rid_opt);
         }
 
-        // Deallocate the page
-        storage_->deallocate_page(rid_opt->page_id);
+        // Free the slot, and the page once its last record is gone
+        erase_record(*rid_opt);
 
         // Remove from primary index
         index_->remove(key);
@@ -625,15 +742,31 @@ public:
      * @brief Clears all records from the table
      */
     void clear() {
-        // Use batch iterator to deallocate pages
+        // Use batch iterator to deallocate pages (each page once, with its
+        // records' overflow chains and the pages its records moved to)
         auto batch_iter = index_->template create_batch_iterator<BatchSize>();
+        std::unordered_set<uint64_t> pages;
+        std::vector<uint64_t> pending;
 
         while (batch_iter.has_more()) {
             auto batch = batch_iter.next_batch();
             for (const auto& [key, rid] : batch) {
-                storage_->deallocate_page(rid.page_id);
+                if (pages.insert(rid.page_id).second) {
+                    pending.push_back(rid.page_id);
+                }
+            }
+            while (!pending.empty()) {
+                uint64_t page_id = pending.back();
+                pending.pop_back();
+                for (uint64_t target : release_page_records(page_id)) {
+                    if (pages.insert(target).second) {
+                        pending.push_back(target);
+                    }
+                }
+                storage_->deallocate_page(page_id);
             }
         }
+        page_space_.clear();
 
         // Clear the index by creating a new one
         index_ = std::make_unique<index_type>(storage_, 0);
@@ -799,10 +932,13 @@ public:
      * @param catalog Pointer to system catalog (not owned)
      *
      * Called by Database after table creation to enable automatic
-     * record count synchronization.
+     * record count synchronization. The count recomputed from the primary
+     * index is handed over at once, which corrects a stale count left in
+     * the catalog by a crash before its last flush.
      */
     void set_catalog(catalog::SystemCatalog* catalog) {
         catalog_ = catalog;
+        sync_catalog_count();
     }
 
 private:
@@ -822,6 +958,9 @@ private:
         /// Insert a record into the index
         virtual void insert_record(const T& record, const RecordId& rid) = 0;
 
+        /// Insert many records into the index at once
+        virtual void insert_records(std::span<const std::pair<const T*, RecordId>> records) = 0;
+
         /// Remove a record from the index
         virtual void remove_record(const T& record, const RecordId& rid) = 0;
 
@@ -900,6 +1039,14 @@ private:
             }
         }
 
+        void insert_records(std::span<const std::pair<const T*, RecordId>> records) override {
+            if (is_unique_) {
+                unique_index_->insert_batch(records);
+            } else {
+                multi_index_->insert_batch(records);
+            }
+        }
+
         void remove_record(const T& record, const RecordId& rid) override {
             if (is_unique_) {
                 unique_index_->remove(record);
@@ -981,21 +1128,244 @@ private:
      * @throws std::runtime_error if record cannot be loaded
      */
     [[nodiscard]] T load_record(const RecordId& rid) const {
-        // Read the page
-        auto page = storage_->read_page(rid.page_id);
+        // Pin the page (no copy - the reader works on the cached frame)
+        auto page = storage_->fetch_page(rid.page_id);
+        uint32_t slot = rid.slot;
+        if (storage::SlottedPage::slot_flags(*page, slot) & storage::SlottedPage::SLOT_FORWARD) {
+            // Moved: follow the stub (one hop, stubs never point at stubs)
+            auto forward = storage::SlottedPage::Forward::decode(storage::SlottedPage::read(*page, slot));
+            page = storage::PageRef{};
+            page = storage_->fetch_page(forward.page_id);
+            slot = forward.slot;
+        }
 
-        // Get record data (simplified - assumes one record per page for now)
-        auto data_span = page.data();
-        std::vector<uint8_t> data(data_span.begin(), data_span.end());
+        auto bytes = storage::SlottedPage::read(*page, slot);
+        if (!(storage::SlottedPage::slot_flags(*page, slot) & storage::SlottedPage::SLOT_OVERFLOW)) {
+            serialization::BinaryReader reader(bytes);
+            return reader.read_custom<T>();
+        }
 
-        // Deserialize
-        serialization::BinaryReader reader(data);
+        // Deserialize straight from the overflow pages, one pinned page at a time
+        auto head = storage::OverflowHead::decode(bytes);
+        storage::OverflowChain::Reader chain(*storage_, head);
+        serialization::BinaryReader reader(head.length, [&chain] { return chain.next(); });
         return reader.read_custom<T>();
     }
 
+    /**
+     * @brief Checks whether a serialized record is too large to live in a data page
+     */
+    [[nodiscard]] bool needs_overflow(std::size_t size) const noexcept {
+        return size > storage::SlottedPage::max_record_size(storage_->get_page_size());
+    }
+
+    /**
+     * @brief Stores a serialized record
+     * @param data Serialized record
+     * @return Where the record was stored
+     * @details A record too large for a page is written to an overflow
+     *          chain; its slot holds the chain's head.
+     */
+    RecordId store_record(std::span<const uint8_t> data) {
+        if (needs_overflow(data.size())) {
+            auto head = storage::OverflowChain::write(*storage_, data).encode();
+            return place_record(head, storage::SlottedPage::SLOT_OVERFLOW);
+        }
+        return place_record(data, 0);
+    }
+
+    /**
+     * @brief Writes slot contents into a page with room for them
+     * @param bytes Serialized record (or overflow head)
+     * @param flags SLOT_* flags of the slot besides SLOT_LIVE
+     * @return Where the bytes were stored
+     * @details Tries the page tracked as the best fit first, then a new page.
+     */
+    RecordId place_record(std::span<const uint8_t> bytes, uint16_t flags) {
+        if (auto page_id = page_space_.find(bytes.size())) {
+            auto page = storage_->fetch_page_mut(*page_id);
+            storage::SlottedPage slotted(*page);
+            auto slot = slotted.insert(bytes, flags);
+            page_space_.update(*page_id, storage::SlottedPage::free_space(*page));
+            if (slot) {
+                return RecordId{*page_id, *slot};
+            }
+        }
+
+        auto page = storage_->new_page(storage::PageType::DATA);
+        storage::SlottedPage slotted(*page);
+        auto slot = slotted.insert(bytes, flags);
+        page_space_.update(page.page_id(), storage::SlottedPage::free_space(*page));
+        return RecordId{page.page_id(), *slot};
+    }
+
+    /**
+     * @brief Replaces a record's slot contents without changing its RecordId
+     * @param rid Record ID (the record's home slot)
+     * @param bytes New slot contents (serialized record or overflow head)
+     * @param flags SLOT_* flags of the new contents besides SLOT_LIVE
+     * @return false if the record would have to move but its home page has
+     *         no room for a forwarding stub (nothing changed)
+     * @details Tries, in order: the slot the record is in now, its home
+     *          slot (a moved record comes back home when it fits again),
+     *          then a slot in another page with the home slot forwarding
+     *          to it. The replaced version's overflow chain is freed.
+     */
+    bool rewrite_record(const RecordId& rid, std::span<const uint8_t> bytes, uint16_t flags) {
+        using storage::SlottedPage;
+        std::optional<SlottedPage::Forward> moved;
+        std::optional<storage::OverflowHead> old_chain;
+        {
+            auto page = storage_->fetch_page_mut(rid.page_id);
+            uint16_t home_flags = SlottedPage::slot_flags(*page, rid.slot);
+            if (home_flags & SlottedPage::SLOT_FORWARD) {
+                moved = SlottedPage::Forward::decode(SlottedPage::read(*page, rid.slot));
+            } else {
+                if (home_flags & SlottedPage::SLOT_OVERFLOW) {
+                    old_chain = storage::OverflowHead::decode(SlottedPage::read(*page, rid.slot));
+                }
+                SlottedPage slotted(*page);
+                if (slotted.update(rid.slot, bytes, flags)) {
+                    page_space_.update(rid.page_id, SlottedPage::free_space(*page));
+                    if (old_chain) {
+                        storage::OverflowChain::free(*storage_, *old_chain);
+                    }
+                    return true;
+                }
+                if (!slotted.can_update(rid.slot, SlottedPage::Forward::SIZE)) {
+                    return false;
+                }
+            }
+        }
+
+        if (moved) {
+            RecordId at{moved->page_id, moved->slot};
+            {
+                auto page = storage_->fetch_page_mut(at.page_id);
+                if (SlottedPage::slot_flags(*page, at.slot) & SlottedPage::SLOT_OVERFLOW) {
+                    old_chain = storage::OverflowHead::decode(SlottedPage::read(*page, at.slot));
+                }
+                SlottedPage slotted(*page);
+                if (slotted.update(at.slot, bytes, flags | SlottedPage::SLOT_MOVED)) {
+                    page_space_.update(at.page_id, SlottedPage::free_space(*page));
+                    if (old_chain) {
+                        storage::OverflowChain::free(*storage_, *old_chain);
+                    }
+                    return true;
+                }
+            }
+            bool home;
+            {
+                auto page = storage_->fetch_page_mut(rid.page_id);
+                SlottedPage slotted(*page);
+                home = slotted.update(rid.slot, bytes, flags);
+                if (home) {
+                    page_space_.update(rid.page_id, SlottedPage::free_space(*page));
+                }
+            }
+            if (home) {
+                erase_slot(at);
+                return true;
+            }
+        }
+
+        // Move to another page and leave a stub at home (it fits: checked above,
+        // or the home slot already holds one)
+        RecordId target = place_record(bytes, flags | SlottedPage::SLOT_MOVED);
+        {
+            auto page = storage_->fetch_page_mut(rid.page_id);
+            SlottedPage slotted(*page);
+            auto stub = SlottedPage::Forward{target.page_id, target.slot}.encode();
+            slotted.update(rid.slot, stub, SlottedPage::SLOT_FORWARD);
+            page_space_.update(rid.page_id, SlottedPage::free_space(*page));
+        }
+        if (moved) {
+            erase_slot(RecordId{moved->page_id, moved->slot});
+        } else if (old_chain) {
+            storage::OverflowChain::free(*storage_, *old_chain);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Prepares a data page for deallocation by freeing what its records own
+     * @param page_id Data page
+     * @return Pages holding records moved out of this page (forwarding targets)
+     * @details Frees the overflow chains of the page's records.
+     */
+    std::vector<uint64_t> release_page_records(uint64_t page_id) {
+        std::vector<storage::OverflowHead> chains;
+        std::vector<uint64_t> targets;
+        {
+            auto page = storage_->fetch_page(page_id);
+            for (uint32_t slot = 0; slot < page->header().record_count; ++slot) {
+                uint16_t flags = storage::SlottedPage::slot_flags(*page, slot);
+                if (flags & storage::SlottedPage::SLOT_OVERFLOW) {
+                    chains.push_back(storage::OverflowHead::decode(storage::SlottedPage::read(*page, slot)));
+                } else if (flags & storage::SlottedPage::SLOT_FORWARD) {
+                    targets.push_back(storage::SlottedPage::Forward::decode(
+                        storage::SlottedPage::read(*page, slot)).page_id);
+                }
+            }
+        }
+        for (const auto& chain : chains) {
+            storage::OverflowChain::free(*storage_, chain);
+        }
+        return targets;
+    }
+
+    /**
+     * @brief Removes a record, following its forwarding stub if it moved
+     * @param rid Record ID (the record's home slot)
+     */
+    void erase_record(const RecordId& rid) {
+        std::optional<storage::SlottedPage::Forward> moved;
+        {
+            auto page = storage_->fetch_page(rid.page_id);
+            if (storage::SlottedPage::slot_flags(*page, rid.slot) & storage::SlottedPage::SLOT_FORWARD) {
+                moved = storage::SlottedPage::Forward::decode(storage::SlottedPage::read(*page, rid.slot));
+            }
+        }
+        if (moved) {
+            erase_slot(RecordId{moved->page_id, moved->slot});
+        }
+        erase_slot(rid);
+    }
+
+    /**
+     * @brief Frees one slot, deallocating its page if it empties
+     * @param rid Page and slot
+     * @details The slot's overflow chain, if any, is deallocated too.
+     */
+    void erase_slot(const RecordId& rid) {
+        bool empty;
+        std::optional<storage::OverflowHead> chain;
+        {
+            auto page = storage_->fetch_page_mut(rid.page_id);
+            if (storage::SlottedPage::slot_flags(*page, rid.slot) & storage::SlottedPage::SLOT_OVERFLOW) {
+                chain = storage::OverflowHead::decode(storage::SlottedPage::read(*page, rid.slot));
+            }
+            storage::SlottedPage slotted(*page);
+            slotted.erase(rid.slot);
+            empty = slotted.live_count() == 0;
+            if (!empty) {
+                page_space_.update(rid.page_id, storage::SlottedPage::free_space(*page));
+            }
+        }
+
+        if (empty) {
+            page_space_.remove(rid.page_id);
+            storage_->deallocate_page(rid.page_id);
+        }
+        if (chain) {
+            storage::OverflowChain::free(*storage_, *chain);
+        }
+    }
+
     /**
      * @brief Synchronize record count with system catalog
-     * @details Defined after SystemCatalog include to avoid incomplete type error
+     * @details Defined after SystemCatalog include to avoid incomplete type error.
+     *          The catalog keeps the count in memory until its next flush.
      */
     void sync_catalog_count();
 
@@ -1006,6 +1376,7 @@ private:
     std::vector<std::unique_ptr<SecondaryIndexBase>> secondary_indexes_;  ///< Secondary indexes
     std::size_t count_;                                       ///< Record count
     catalog::SystemCatalog* catalog_;                         ///< System catalog (not owned)
+    storage::PageSpaceTracker page_space_;                    ///< Free space of this table's data pages
 };
 
 // Forward declaration for Query (defined in Query.hpp)
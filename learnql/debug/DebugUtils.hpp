@@ -5,6 +5,7 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <cmath>
 #include <chrono>
 #include <vector>
 
@@ -1,12 +1,14 @@
 #ifndef LEARNQL_DEBUG_STATISTICS_HPP
 #define LEARNQL_DEBUG_STATISTICS_HPP
 
+#include "../storage/IoStats.hpp"
 #include <string>
 #include <unordered_map>
 #include <vector>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
+#include <chrono>
 
 namespace learnql::debug {
 
@@ -95,6 +97,28 @@ struct QueryStatistics {
     }
 };
 
+/**
+ * @brief Buffer pool and disk traffic statistics of one database file
+ */
+struct StorageStatistics {
+    std::string database;        ///< Database file path
+    std::size_t page_size = 0;
+    std::size_t cache_size = 0;  ///< Buffer pool frames
+    storage::IoStats io;         ///< Snapshot from StorageEngine::get_io_stats()
+
+    void print() const {
+        std::cout << "Storage: " << database << "\n";
+        std::cout << "  Cache: " << cache_size << " pages of " << page_size << " bytes\n";
+        std::cout << "  Hits / misses: " << io.cache_hits << " / " << io.cache_misses
+                  << " (hit ratio " << std::fixed << std::setprecision(2) << io.hit_ratio() * 100.0 << "%)\n";
+        std::cout << "  Evictions: " << io.evictions << " (" << io.dirty_evictions << " dirty)\n";
+        std::cout << "  Pages read: " << io.pages_read << " (" << io.bytes_read << " bytes)\n";
+        std::cout << "  Pages written: " << io.pages_written << " (" << io.bytes_written << " bytes)\n";
+        std::cout << "  Flushes: " << io.flushes << " (avg " << std::fixed << std::setprecision(3)
+                  << io.average_flush_ms() << " ms)\n";
+    }
+};
+
 /**
  * @brief Statistics collector for database objects
  *
@@ -125,6 +149,13 @@ public:
         index_stats_[stats.index_name] = stats;
     }
 
+    /**
+     * @brief Records storage statistics (see core::Database::record_statistics())
+     */
+    void record_storage(const StorageStatistics& stats) {
+        storage_stats_[stats.database] = stats;
+    }
+
     /**
      * @brief Records a query execution
      */
@@ -155,12 +186,29 @@ public:
         return it != index_stats_.end() ? &it->second : nullptr;
     }
 
+    /**
+     * @brief Gets storage statistics
+     */
+    [[nodiscard]] const StorageStatistics* get_storage_stats(const std::string& database) const {
+        auto it = storage_stats_.find(database);
+        return it != storage_stats_.end() ? &it->second : nullptr;
+    }
+
     /**
      * @brief Prints all statistics
      */
     void print_all() const {
         std::cout << "\n=== Database Statistics ===\n\n";
 
+        // Storage statistics
+        if (!storage_stats_.empty()) {
+            std::cout << "--- Storage Statistics ---\n";
+            for (const auto& [name, stats] : storage_stats_) {
+                stats.print();
+                std::cout << "\n";
+            }
+        }
+
         // Table statistics
         if (!table_stats_.empty()) {
             std::cout << "--- Table Statistics ---\n";
@@ -208,6 +256,7 @@ public:
         table_stats_.clear();
         index_stats_.clear();
         query_stats_.clear();
+        storage_stats_.clear();
     }
 
 private:
@@ -220,6 +269,7 @@ private:
     std::unordered_map<std::string, TableStatistics> table_stats_;
     std::unordered_map<std::string, IndexStatistics> index_stats_;
     std::unordered_map<std::string, QueryStatistics> query_stats_;
+    std::unordered_map<std::string, StorageStatistics> storage_stats_;
 };
 
 } // namespace learnql::debug
@@ -12,7 +12,9 @@
 #include <algorithm>
 #include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <stdexcept>
+#include <span>
 
 namespace learnql::index {
 
@@ -41,10 +43,12 @@ namespace learnql::index {
  *
  * Architecture:
  * - Each B+tree node is stored in a separate INDEX page
+ * - Node fanout grows with the database's page size (ORDER children per 4KB)
  * - Nodes reference children by page ID instead of pointers
  * - Leaf nodes linked via next/prev page IDs
  * - Root page ID is stored in metadata for recovery
- * - LRU-like node cache reduces disk I/O
+ * - LRU-like node cache reduces disk I/O (CACHE_SIZE nodes, or a share of
+ *   the storage engine's MemoryGovernor budget when one is attached)
  *
  * Example:
  * @code
@@ -59,10 +63,16 @@ template<typename Key, typename Value = core::RecordId>
 requires std::totally_ordered<Key>
 class PersistentBTreeIndex {
 private:
-    static constexpr std::size_t ORDER = 4; // B-tree order (max children per node)
-    static constexpr std::size_t MIN_KEYS = ORDER / 2 - 1;
-    static constexpr std::size_t MAX_KEYS = ORDER - 1;
-    static constexpr std::size_t CACHE_SIZE = 32; // Number of nodes to cache
+    static constexpr std::size_t ORDER = 4; // B-tree order on a 4KB page (max children per node)
+    static constexpr std::size_t CACHE_SIZE = 32; // Number of nodes to cache (initial share under a governor)
+    static constexpr std::size_t MIN_CACHE_NODES = 4; // Smallest cache a memory governor may leave
+    static constexpr double NODE_MISS_COST = 0.25; // A node miss decodes a page, usually still in the buffer pool
+
+    /**
+     * @brief Internal nodes from the root down to a leaf's parent, each
+     *        paired with the index of the child taken
+     */
+    using LeafPath = std::vector<std::pair<uint64_t, std::size_t>>;
 
     /**
      * @brief Serializable B+tree node structure
@@ -84,17 +94,9 @@ private:
         uint64_t next_page_id;               ///< Next leaf page (0 if none, leaf nodes only)
         uint64_t prev_page_id;               ///< Previous leaf page (0 if none, leaf nodes only)
 
-        Node() : page_id(0), is_leaf(true), next_page_id(0), prev_page_id(0) {
-            keys.reserve(MAX_KEYS);
-            values.reserve(MAX_KEYS);
-            children_ids.reserve(ORDER);
-        }
+        Node() : page_id(0), is_leaf(true), next_page_id(0), prev_page_id(0) {}
 
-        explicit Node(uint64_t pid) : page_id(pid), is_leaf(true), next_page_id(0), prev_page_id(0) {
-            keys.reserve(MAX_KEYS);
-            values.reserve(MAX_KEYS);
-            children_ids.reserve(ORDER);
-        }
+        explicit Node(uint64_t pid) : page_id(pid), is_leaf(true), next_page_id(0), prev_page_id(0) {}
 
         /**
          * @brief Serializes the node to a BinaryWriter
@@ -199,16 +201,18 @@ private:
 
         /**
          * @brief Checks if node is full
+         * @param max_keys Maximum keys per node for this tree
          */
-        [[nodiscard]] bool is_full() const {
-            return keys.size() >= MAX_KEYS;
+        [[nodiscard]] bool is_full(std::size_t max_keys) const {
+            return keys.size() >= max_keys;
         }
 
         /**
          * @brief Checks if node has minimum keys
+         * @param min_keys Minimum keys per node for this tree
          */
-        [[nodiscard]] bool has_min_keys() const {
-            return keys.size() >= MIN_KEYS;
+        [[nodiscard]] bool has_min_keys(std::size_t min_keys) const {
+            return keys.size() >= min_keys;
         }
     };
 
@@ -221,10 +225,19 @@ public:
     explicit PersistentBTreeIndex(std::shared_ptr<storage::StorageEngine> storage,
                                    uint64_t root_page_id = 0)
         : storage_(std::move(storage)),
+          order_(ORDER * (storage_->get_page_size() / storage::PAGE_SIZE)),
+          max_keys_(order_ - 1),
           root_page_id_(root_page_id),
           size_(0),
           node_cache_(),
-          dirty_nodes_() {
+          dirty_nodes_(),
+          cache_budget_() {
+
+        if (auto governor = storage_->get_memory_governor()) {
+            std::size_t node_bytes = storage_->get_page_size();
+            cache_budget_ = governor->register_cache("index nodes", node_bytes, MIN_CACHE_NODES,
+                                                     NODE_MISS_COST, CACHE_SIZE * node_bytes);
+        }
 
         if (root_page_id_ == 0) {
             // Create a new root node
@@ -256,7 +269,7 @@ public:
         Node root = load_node(root_page_id_);
 
         // If root is full, split it
-        if (root.is_full()) {
+        if (root.is_full(max_keys_)) {
             uint64_t new_root_id = allocate_node(false);
             Node new_root = load_node(new_root_id);
             new_root.children_ids.push_back(root_page_id_);
@@ -273,6 +286,55 @@ public:
         return inserted;
     }
 
+    /**
+     * @brief Inserts many key-value pairs given in key order
+     * @param entries Pairs sorted by key
+     * @return Number of pairs inserted (a key already present, or repeated
+     *         in entries, keeps its first value, as with insert())
+     * @details When the batch is at least as large as the tree, the tree is
+     *          rebuilt bottom-up with the existing entries merged in: every
+     *          node is written full, once, and the leaves take one
+     *          contiguous run of pages. A smaller batch is inserted one key
+     *          at a time, in order, so the same nodes stay cached.
+     */
+    std::size_t insert_sorted(std::span<const std::pair<Key, Value>> entries) {
+        if (entries.empty()) {
+            return 0;
+        }
+
+        if (entries.size() < size_) {
+            std::size_t inserted = 0;
+            for (const auto& [key, value] : entries) {
+                inserted += insert(key, value) ? 1 : 0;
+            }
+            return inserted;
+        }
+
+        std::size_t before = size_;
+        if (size_ == 0) {
+            rebuild(entries);
+            return size_;
+        }
+
+        // Merge with the existing entries (which win on equal keys)
+        auto existing = get_all();
+        std::vector<std::pair<Key, Value>> merged;
+        merged.reserve(existing.size() + entries.size());
+        auto it = existing.begin();
+        for (const auto& entry : entries) {
+            while (it != existing.end() && it->first < entry.first) {
+                merged.push_back(std::move(*it++));
+            }
+            if (it != existing.end() && it->first == entry.first) {
+                continue;
+            }
+            merged.push_back(entry);
+        }
+        merged.insert(merged.end(), std::make_move_iterator(it), std::make_move_iterator(existing.end()));
+        rebuild(merged);
+        return size_ - before;
+    }
+
     /**
      * @brief Finds a value by key
      * @param key The key to search for
@@ -447,6 +509,96 @@ private:
         storage_->deallocate_page(page_id);
     }
 
+    /**
+     * @brief Replaces the tree's contents with sorted entries, built bottom-up
+     * @param entries Pairs sorted by key (of equal keys only the first is kept)
+     * @details Each level spreads its entries (or children) evenly over as
+     *          few nodes as max_keys_ (or order_) allows, so nodes are full
+     *          or nearly so; leaves are linked left to right. Nodes are written straight to their
+     *          pages rather than through the node cache. The top node takes
+     *          over the root page, so the root page ID does not change.
+     */
+    void rebuild(std::span<const std::pair<Key, Value>> entries) {
+        // Free the old nodes but keep the root's page
+        std::vector<uint64_t> old_nodes;
+        collect_nodes(root_page_id_, old_nodes);
+        for (uint64_t page_id : old_nodes) {
+            if (page_id != root_page_id_) {
+                deallocate_node(page_id);
+            }
+        }
+        node_cache_.erase(root_page_id_);
+        dirty_nodes_.erase(root_page_id_);
+
+        std::vector<std::pair<Key, Value>> unique;
+        unique.reserve(entries.size());
+        for (const auto& entry : entries) {
+            if (unique.empty() || unique.back().first < entry.first) {
+                unique.push_back(entry);
+            }
+        }
+        size_ = unique.size();
+
+        // Leaves, in one run of pages (a single leaf is the root itself)
+        std::size_t leaf_count = std::max<std::size_t>(1, (unique.size() + max_keys_ - 1) / max_keys_);
+        uint64_t first_leaf = leaf_count == 1 ? root_page_id_
+                                              : storage_->allocate_pages(leaf_count, storage::PageType::INDEX);
+        std::vector<std::pair<Key, uint64_t>> level;  // (smallest key, page ID) per node
+        level.reserve(leaf_count);
+        std::size_t next = 0;
+        for (std::size_t i = 0; i < leaf_count; ++i) {
+            Node leaf(first_leaf + i);
+            std::size_t fill = unique.size() / leaf_count + (i < unique.size() % leaf_count ? 1 : 0);
+            for (std::size_t j = 0; j < fill; ++j, ++next) {
+                leaf.keys.push_back(std::move(unique[next].first));
+                leaf.values.push_back(std::move(unique[next].second));
+            }
+            leaf.prev_page_id = i > 0 ? first_leaf + i - 1 : 0;
+            leaf.next_page_id = i + 1 < leaf_count ? first_leaf + i + 1 : 0;
+            write_node_to_page(leaf);
+            if (!leaf.keys.empty()) {
+                level.emplace_back(leaf.keys.front(), leaf.page_id);
+            }
+        }
+
+        // Internal levels up to a single top node
+        while (level.size() > 1) {
+            std::size_t node_count = (level.size() + order_ - 1) / order_;
+            uint64_t first = node_count == 1 ? root_page_id_
+                                             : storage_->allocate_pages(node_count, storage::PageType::INDEX);
+            std::vector<std::pair<Key, uint64_t>> parents;
+            parents.reserve(node_count);
+            std::size_t child = 0;
+            for (std::size_t i = 0; i < node_count; ++i) {
+                Node node(first + i);
+                node.is_leaf = false;
+                std::size_t fanout = level.size() / node_count + (i < level.size() % node_count ? 1 : 0);
+                parents.emplace_back(level[child].first, node.page_id);
+                for (std::size_t j = 0; j < fanout; ++j, ++child) {
+                    if (j > 0) {
+                        node.keys.push_back(level[child].first);
+                    }
+                    node.children_ids.push_back(level[child].second);
+                }
+                write_node_to_page(node);
+            }
+            level = std::move(parents);
+        }
+    }
+
+    /**
+     * @brief Collects the page IDs of a subtree's nodes
+     */
+    void collect_nodes(uint64_t node_id, std::vector<uint64_t>& page_ids) const {
+        page_ids.push_back(node_id);
+        Node node = load_node(node_id);
+        if (!node.is_leaf) {
+            for (uint64_t child : node.children_ids) {
+                collect_nodes(child, page_ids);
+            }
+        }
+    }
+
     /**
      * @brief Loads a node from disk (with caching)
      * @param page_id Page ID of the node
@@ -456,20 +608,25 @@ private:
         // Check cache first
         auto it = node_cache_.find(page_id);
         if (it != node_cache_.end()) {
+            if (cache_budget_) {
+                cache_budget_->record_hit();
+            }
             return it->second;
         }
+        if (cache_budget_) {
+            cache_budget_->record_miss();
+        }
 
-        // Load from disk
-        storage::Page page = storage_->read_page(page_id);
+        // Load from disk, deserializing straight from the pinned frame
         Node node;
+        {
+            storage::PageRef page = storage_->fetch_page(page_id);
+            serialization::BinaryReader reader(page->data());
+            node.deserialize(reader);
+        }
 
-        // Deserialize the node from the page
-        auto data_span = page.data();
-        serialization::BinaryReader reader(data_span);
-        node.deserialize(reader);
-
-        // Add to cache (evict if necessary)
-        if (node_cache_.size() >= CACHE_SIZE) {
+        // Add to cache (evict if necessary; a governor may have shrunk the share)
+        while (!node_cache_.empty() && node_cache_.size() >= cache_capacity()) {
             evict_node();
         }
         node_cache_[page_id] = node;
@@ -484,6 +641,20 @@ private:
     void save_node(const Node& node) {
         node_cache_[node.page_id] = node;
         dirty_nodes_.insert(node.page_id);
+
+        // Under a memory budget dirty nodes count too: write some back
+        if (cache_budget_) {
+            while (node_cache_.size() > cache_capacity()) {
+                evict_node();
+            }
+        }
+    }
+
+    /**
+     * @brief Number of nodes the cache may hold
+     */
+    [[nodiscard]] std::size_t cache_capacity() const noexcept {
+        return cache_budget_ ? cache_budget_->limit_units() : CACHE_SIZE;
     }
 
     /**
@@ -491,22 +662,18 @@ private:
      * @param node Node to write
      */
     void write_node_to_page(const Node& node) const {
-        storage::Page page(node.page_id, storage::PageType::INDEX);
-
         // Serialize the node
         serialization::BinaryWriter writer;
         node.serialize(writer);
 
         auto buffer = writer.get_buffer();
-        if (buffer.size() > storage::Page::DATA_SIZE) {
+        if (buffer.size() > storage_->get_page_size() - sizeof(storage::PageHeader)) {
             throw std::runtime_error("Node too large to fit in a single page");
         }
 
-        // Write to page data
-        page.write_data(0, buffer.data(), buffer.size());
-
-        // Write the page to storage
-        storage_->write_page(node.page_id, page);
+        // Write into the page's frame (old contents are not read back)
+        storage::PageGuard page = storage_->reset_page(node.page_id, storage::PageType::INDEX);
+        page->write_data(0, buffer.data(), buffer.size());
     }
 
     /**
@@ -525,11 +692,13 @@ private:
             }
         }
 
-        // If all nodes are dirty, flush and evict the first one
-        uint64_t page_id = node_cache_.begin()->first;
-        write_node_to_page(node_cache_.begin()->second);
-        dirty_nodes_.erase(page_id);
-        node_cache_.erase(page_id);
+        // If all nodes are dirty, write them all back (so the next evictions
+        // find clean nodes at once) and evict the first one
+        for (uint64_t page_id : dirty_nodes_) {
+            write_node_to_page(node_cache_.at(page_id));
+        }
+        dirty_nodes_.clear();
+        node_cache_.erase(node_cache_.begin());
     }
 
     /**
@@ -592,8 +761,11 @@ private:
             return true;
         } else {
             // Internal node: find the correct child to descend to
+            // (key >= keys[i] goes right, as in search(); a key equal to a
+            // separator left behind by remove() belongs in the right child)
+            i = std::upper_bound(node.keys.begin(), node.keys.end(), key) - node.keys.begin();
             Node child = load_node(node.children_ids[i]);
-            if (child.is_full()) {
+            if (child.is_full(max_keys_)) {
                 split_child(node, i);
                 // After split, re-evaluate which child to use
                 // In B+Tree: separator key K means left has keys < K, right has keys >= K
@@ -618,7 +790,7 @@ private:
         uint64_t new_node_id = allocate_node(full_child.is_leaf);
         Node new_node = load_node(new_node_id);
 
-        std::size_t mid = MAX_KEYS / 2;
+        std::size_t mid = max_keys_ / 2;
 
         if (full_child.is_leaf) {
             // LEAF NODE SPLIT (B+Tree specific)
@@ -739,38 +911,112 @@ private:
         }
 
         // Step 1: Find the starting leaf node
-        uint64_t leaf_id = find_leaf_for_key(node_id, min_key);
+        LeafPath path;
+        uint64_t leaf_id = find_leaf_for_key(node_id, min_key, &path);
         if (leaf_id == 0) {
             return;
         }
 
         // Step 2: Walk the leaf linked list, collecting values in range
-        while (leaf_id != 0) {
-            Node leaf = load_node(leaf_id);
-
+        walk_leaves(leaf_id, path, [&](const Node& leaf) {
             // Collect values from this leaf that are in range
             for (std::size_t i = 0; i < leaf.keys.size(); ++i) {
                 if (leaf.keys[i] < min_key) {
                     continue; // Skip keys below minimum
                 }
                 if (leaf.keys[i] > max_key) {
-                    return; // All done, keys are sorted
+                    return false; // All done, keys are sorted
                 }
                 results.push_back(leaf.values[i]);
             }
+            return true;
+        });
+    }
+
+    /**
+     * @brief Visits leaves in key order, following the leaf linked list
+     * @param leaf_id First leaf
+     * @param path Path to the first leaf (from find_leaf_for_key / find_leftmost_leaf)
+     * @param visit Called with each leaf; returns false to stop
+     *
+     * With an asynchronous I/O backend, the next StorageOptions::readahead_pages
+     * leaves are requested in one batch each time the walk catches up with
+     * the previous batch. (Leaves allocated in order are also picked up by
+     * the engine's own sequential readahead.)
+     */
+    template<typename Visit>
+    void walk_leaves(uint64_t leaf_id, LeafPath path, Visit&& visit) const {
+        bool readahead = storage_->supports_prefetch() && storage_->get_options().readahead_pages > 0;
+        std::size_t ahead = 0;  // Prefetched leaves not reached yet
+
+        while (leaf_id != 0) {
+            if (readahead && ahead == 0) {
+                ahead = prefetch_next_leaves(path);
+            }
+
+            Node leaf = load_node(leaf_id);
+            if (!visit(leaf)) {
+                return;
+            }
 
             // Move to next leaf in the linked list
             leaf_id = leaf.next_page_id;
+            if (ahead > 0) {
+                --ahead;
+            }
         }
     }
 
+    /**
+     * @brief Prefetches the leaves that follow the one a path leads to
+     * @param path Path to a leaf; moved to the last leaf prefetched
+     * @return Number of leaves requested
+     * @details Leaf IDs are taken from the internal nodes above the leaves
+     *          (all leaves sit at the same depth), so no leaf is read just
+     *          to find its successor. Internal nodes passed on the way are
+     *          prefetched along with their right siblings.
+     */
+    std::size_t prefetch_next_leaves(LeafPath& path) const {
+        std::vector<uint64_t> leaves;
+        const std::size_t depth = path.size();
+
+        while (leaves.size() < storage_->get_options().readahead_pages) {
+            // Climb to the lowest ancestor with a child further right
+            while (!path.empty()) {
+                Node node = load_node(path.back().first);
+                if (path.back().second + 1 < node.children_ids.size()) {
+                    ++path.back().second;
+                    break;
+                }
+                path.pop_back();
+            }
+            if (path.empty()) {
+                break;  // The last leaf has been reached
+            }
+
+            // Descend along leftmost children back to the leaves' parents,
+            // reading each internal node together with its right siblings
+            while (path.size() < depth) {
+                Node node = load_node(path.back().first);
+                auto upcoming = std::span<const uint64_t>(node.children_ids).subspan(path.back().second);
+                storage_->prefetch_pages(upcoming);
+                path.emplace_back(node.children_ids[path.back().second], 0);
+            }
+            leaves.push_back(load_node(path.back().first).children_ids[path.back().second]);
+        }
+
+        storage_->prefetch_pages(leaves);
+        return leaves.size();
+    }
+
     /**
      * @brief Finds the leaf node that would contain the given key
      *
      * This helper traverses from a starting node to the leaf level,
-     * following the appropriate child pointers.
+     * following the appropriate child pointers. If path is given, the
+     * internal nodes passed (and the child taken in each) are appended.
      */
-    uint64_t find_leaf_for_key(uint64_t node_id, const Key& key) const {
+    uint64_t find_leaf_for_key(uint64_t node_id, const Key& key, LeafPath* path = nullptr) const {
         if (node_id == 0) {
             return 0;
         }
@@ -788,7 +1034,10 @@ private:
             ++i;
         }
 
-        return find_leaf_for_key(node.children_ids[i], key);
+        if (path != nullptr) {
+            path->emplace_back(node_id, i);
+        }
+        return find_leaf_for_key(node.children_ids[i], key, path);
     }
 
     /**
@@ -803,28 +1052,26 @@ private:
         }
 
         // Find the leftmost leaf (contains smallest keys)
-        uint64_t leaf_id = find_leftmost_leaf(node_id);
+        LeafPath path;
+        uint64_t leaf_id = find_leftmost_leaf(node_id, &path);
         if (leaf_id == 0) {
             return;
         }
 
         // Walk the leaf linked list, collecting all key-value pairs
-        while (leaf_id != 0) {
-            Node leaf = load_node(leaf_id);
-
+        walk_leaves(leaf_id, path, [&results](const Node& leaf) {
             for (std::size_t i = 0; i < leaf.keys.size(); ++i) {
                 results.emplace_back(leaf.keys[i], leaf.values[i]);
             }
-
-            // Move to next leaf
-            leaf_id = leaf.next_page_id;
-        }
+            return true;
+        });
     }
 
     /**
      * @brief Finds the leftmost (first) leaf node
+     * @param path If given, receives the internal nodes passed (see find_leaf_for_key)
      */
-    uint64_t find_leftmost_leaf(uint64_t node_id) const {
+    uint64_t find_leftmost_leaf(uint64_t node_id, LeafPath* path = nullptr) const {
         if (node_id == 0) {
             return 0;
         }
@@ -837,7 +1084,10 @@ private:
         }
 
         // Internal node: follow the leftmost child
-        return find_leftmost_leaf(node.children_ids[0]);
+        if (path != nullptr) {
+            path->emplace_back(node_id, 0);
+        }
+        return find_leftmost_leaf(node.children_ids[0], path);
     }
 
     /**
@@ -852,28 +1102,31 @@ private:
         }
 
         // Find the leftmost leaf
-        uint64_t leaf_id = find_leftmost_leaf(node_id);
+        LeafPath path;
+        uint64_t leaf_id = find_leftmost_leaf(node_id, &path);
         if (leaf_id == 0) {
             return 0;
         }
 
         // Walk the leaf linked list and count entries
         std::size_t count = 0;
-        while (leaf_id != 0) {
-            Node leaf = load_node(leaf_id);
+        walk_leaves(leaf_id, path, [&count](const Node& leaf) {
             count += leaf.keys.size();
-            leaf_id = leaf.next_page_id;
-        }
+            return true;
+        });
 
         return count;
     }
 
 private:
     std::shared_ptr<storage::StorageEngine> storage_;  ///< Storage engine
+    std::size_t order_;                                ///< Max children per node (scales with the page size)
+    std::size_t max_keys_;                             ///< Max keys per node (order_ - 1)
     uint64_t root_page_id_;                            ///< Root node page ID
     std::size_t size_;                                 ///< Number of entries
     mutable std::unordered_map<uint64_t, Node> node_cache_; ///< Node cache
     mutable std::unordered_set<uint64_t> dirty_nodes_;      ///< Dirty node tracking
+    std::shared_ptr<storage::MemoryBudget> cache_budget_;   ///< Node cache share (null without a governor)
 };
 
 } // namespace learnql::index
@@ -9,6 +9,8 @@
 #include <string>
 #include <optional>
 #include <memory>
+#include <span>
+#include <algorithm>
 #include <limits>
 #include <compare>
 
@@ -18,29 +20,43 @@ namespace learnql::index {
  * @brief Composite key for multi-value secondary indexes
  * @tparam FieldType Type of the indexed field
  *
- * Combines field value with page ID to create unique composite keys.
- * This allows multiple records with the same field value.
+ * Combines field value with the record's location to create unique
+ * composite keys. This allows multiple records with the same field value.
  *
  * Example: If two users have email "test@example.com":
- * - User 1 (page 10): composite key = ("test@example.com", 10)
- * - User 2 (page 20): composite key = ("test@example.com", 20)
+ * - User 1 (page 10, slot 0): composite key = ("test@example.com", 10)
+ * - User 2 (page 10, slot 3): composite key = ("test@example.com", 3 << 48 | 10)
  *
  * Both stored as separate B+Tree entries, enabling range queries.
+ *
+ * The location is packed into one integer (slot in the top 16 bits), so
+ * keys written when every record had its own page (slot 0) keep their
+ * meaning.
  */
 template<typename FieldType>
 struct CompositeKey {
     FieldType field_value;
-    uint64_t page_id;
+    uint64_t record;   ///< Packed RecordId (see pack())
+
+    CompositeKey() : field_value{}, record(0) {}
+
+    CompositeKey(FieldType value, uint64_t packed)
+        : field_value(std::move(value)), record(packed) {}
 
-    CompositeKey() : field_value{}, page_id(0) {}
+    CompositeKey(FieldType value, const core::RecordId& rid)
+        : field_value(std::move(value)), record(pack(rid)) {}
 
-    CompositeKey(FieldType value, uint64_t pid)
-        : field_value(std::move(value)), page_id(pid) {}
+    /**
+     * @brief Packs a RecordId into one integer (slot << 48 | page)
+     */
+    [[nodiscard]] static constexpr uint64_t pack(const core::RecordId& rid) noexcept {
+        return (static_cast<uint64_t>(rid.slot) << 48) | rid.page_id;
+    }
 
     // Comparison operators for B+Tree ordering
     // Note: Using explicit comparisons for better compatibility
     bool operator==(const CompositeKey& other) const {
-        return field_value == other.field_value && page_id == other.page_id;
+        return field_value == other.field_value && record == other.record;
     }
 
     bool operator!=(const CompositeKey& other) const {
@@ -50,7 +66,7 @@ struct CompositeKey {
     bool operator<(const CompositeKey& other) const {
         if (field_value < other.field_value) return true;
         if (other.field_value < field_value) return false;
-        return page_id < other.page_id;
+        return record < other.record;
     }
 
     bool operator<=(const CompositeKey& other) const {
@@ -69,8 +85,8 @@ struct CompositeKey {
     auto operator<=>(const CompositeKey& other) const {
         if (field_value < other.field_value) return std::strong_ordering::less;
         if (other.field_value < field_value) return std::strong_ordering::greater;
-        if (page_id < other.page_id) return std::strong_ordering::less;
-        if (page_id > other.page_id) return std::strong_ordering::greater;
+        if (record < other.record) return std::strong_ordering::less;
+        if (record > other.record) return std::strong_ordering::greater;
         return std::strong_ordering::equal;
     }
 
@@ -84,7 +100,7 @@ struct CompositeKey {
         } else {
             writer.write(field_value);
         }
-        writer.write(page_id);
+        writer.write(record);
     }
 
     template<typename Reader>
@@ -96,7 +112,7 @@ struct CompositeKey {
         } else {
             field_value.deserialize(reader);
         }
-        page_id = reader.template read<uint64_t>();
+        record = reader.template read<uint64_t>();
     }
 };
 
@@ -168,14 +184,32 @@ public:
      * @param rid RecordId of the record
      * @return true if inserted successfully
      *
-     * Uses composite key (field_value, page_id) to ensure uniqueness.
+     * Uses composite key (field_value, record location) to ensure uniqueness.
      */
     bool insert(const T& record, const core::RecordId& rid) {
         FieldType field_value = getter_(record);
-        composite_key_type key(field_value, rid.page_id);
+        composite_key_type key(field_value, rid);
         return index_->insert(key, rid);
     }
 
+    /**
+     * @brief Inserts many records at once
+     * @param records Records with their RecordIds
+     * @return Number of records indexed
+     * @details The composite keys are sorted and handed to the B+tree in
+     *          one go (see PersistentBTreeIndex::insert_sorted).
+     */
+    std::size_t insert_batch(std::span<const std::pair<const T*, core::RecordId>> records) {
+        std::vector<std::pair<composite_key_type, core::RecordId>> entries;
+        entries.reserve(records.size());
+        for (const auto& [record, rid] : records) {
+            entries.emplace_back(composite_key_type(getter_(*record), rid), rid);
+        }
+        std::sort(entries.begin(), entries.end(),
+                  [](const auto& a, const auto& b) { return a.first < b.first; });
+        return index_->insert_sorted(entries);
+    }
+
     /**
      * @brief Finds all records with a given field value
      * @param value Field value to search for
@@ -219,7 +253,7 @@ public:
      */
     bool remove(const T& record, const core::RecordId& rid) {
         FieldType field_value = getter_(record);
-        composite_key_type key(field_value, rid.page_id);
+        composite_key_type key(field_value, rid);
         return index_->remove(key);
     }
 
@@ -233,7 +267,7 @@ public:
         std::size_t removed_count = 0;
 
         for (const auto& rid : rids) {
-            composite_key_type key(value, rid.page_id);
+            composite_key_type key(value, rid);
             if (index_->remove(key)) {
                 ++removed_count;
             }
@@ -261,13 +295,13 @@ public:
         }
 
         // Remove old entry
-        composite_key_type old_key(old_value, rid.page_id);
+        composite_key_type old_key(old_value, rid);
         if (!index_->remove(old_key)) {
             return false;
         }
 
         // Insert new entry
-        composite_key_type new_key(new_value, rid.page_id);
+        composite_key_type new_key(new_value, rid);
         return index_->insert(new_key, rid);
     }
 
@@ -9,6 +9,8 @@
 #include <string>
 #include <optional>
 #include <memory>
+#include <span>
+#include <algorithm>
 
 namespace learnql::index {
 
@@ -82,6 +84,26 @@ public:
         return index_->insert(field_value, rid);
     }
 
+    /**
+     * @brief Inserts many records at once
+     * @param records Records with their RecordIds
+     * @return Number of records indexed (as with insert(), a field value
+     *         already indexed keeps its record; within the batch the first
+     *         record wins)
+     * @details The entries are sorted by field value and handed to the
+     *          B+tree in one go (see PersistentBTreeIndex::insert_sorted).
+     */
+    std::size_t insert_batch(std::span<const std::pair<const T*, core::RecordId>> records) {
+        std::vector<std::pair<FieldType, core::RecordId>> entries;
+        entries.reserve(records.size());
+        for (const auto& [record, rid] : records) {
+            entries.emplace_back(getter_(*record), rid);
+        }
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        return index_->insert_sorted(entries);
+    }
+
     /**
      * @brief Finds a record by field value
      * @param value Field value to search for
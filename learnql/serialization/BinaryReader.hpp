@@ -7,6 +7,8 @@
 #include <span>
 #include <bit>
 #include <stdexcept>
+#include <functional>
+#include <algorithm>
 
 namespace learnql::serialization {
 
@@ -22,6 +24,8 @@ class BinaryWriter;
  * - Automatic endianness handling
  * - Support for primitives, strings, containers
  * - Bounds checking
+ * - Buffers split into chunks (e.g. a record spread over overflow pages),
+ *   read in order without being copied into one buffer first
  *
  * Example:
  * @code
@@ -33,19 +37,39 @@ class BinaryWriter;
  */
 class BinaryReader {
 public:
+    /**
+     * @brief Supplies the next chunk of a chunked buffer (empty when there is none)
+     */
+    using ChunkSource = std::function<std::span<const uint8_t>()>;
+
     /**
      * @brief Constructs a reader from a span of bytes
      * @param data Span of bytes to read from
      */
     explicit BinaryReader(std::span<const uint8_t> data)
-        : data_{data}, position_{0} {}
+        : data_{data}, position_{0}, chunk_offset_{0}, size_{data.size()}, next_chunk_{} {}
 
     /**
      * @brief Constructs a reader from a vector
      * @param data Vector of bytes to read from
      */
     explicit BinaryReader(const std::vector<uint8_t>& data)
-        : data_{std::span<const uint8_t>(data.data(), data.size())}, position_{0} {}
+        : data_{std::span<const uint8_t>(data.data(), data.size())},
+          position_{0},
+          chunk_offset_{0},
+          size_{data.size()},
+          next_chunk_{} {}
+
+    /**
+     * @brief Constructs a reader over a buffer delivered in chunks
+     * @param size Total size of the buffer in bytes
+     * @param next_chunk Called for each chunk in order, when the previous one is used up
+     * @details Each chunk only has to stay valid until the next call. Values
+     *          may straddle chunks; read_bytes() and seek() are limited to
+     *          the current chunk.
+     */
+    BinaryReader(std::size_t size, ChunkSource next_chunk)
+        : data_{}, position_{0}, chunk_offset_{0}, size_{size}, next_chunk_{std::move(next_chunk)} {}
 
     /**
      * @brief Reads an arithmetic type (int, float, etc.)
@@ -172,21 +196,39 @@ public:
      * @throws std::runtime_error if not enough data
      */
     void read_raw(void* dest, std::size_t size) {
-        if (position_ + size > data_.size()) {
+        if (position_ + size <= data_.size()) {
+            std::memcpy(dest, data_.data() + position_, size);
+            position_ += size;
+            return;
+        }
+        if (size > remaining()) {
             throw std::runtime_error("Not enough data to read");
         }
 
-        std::memcpy(dest, data_.data() + position_, size);
-        position_ += size;
+        // Spans chunks: copy piece by piece
+        auto* out = static_cast<uint8_t*>(dest);
+        while (size > 0) {
+            if (position_ == data_.size()) {
+                load_next_chunk();
+            }
+            std::size_t piece = std::min(size, data_.size() - position_);
+            std::memcpy(out, data_.data() + position_, piece);
+            position_ += piece;
+            out += piece;
+            size -= piece;
+        }
     }
 
     /**
      * @brief Reads a span of bytes
      * @param size Number of bytes to read
      * @return Span of read bytes (view into original buffer)
-     * @throws std::runtime_error if not enough data
+     * @throws std::runtime_error if not enough data in the current chunk
      */
     [[nodiscard]] std::span<const uint8_t> read_bytes(std::size_t size) {
+        if (position_ == data_.size() && size > 0 && size <= remaining()) {
+            load_next_chunk();
+        }
         if (position_ + size > data_.size()) {
             throw std::runtime_error("Not enough data to read");
         }
@@ -201,7 +243,7 @@ public:
      * @return Current position in bytes
      */
     [[nodiscard]] std::size_t position() const noexcept {
-        return position_;
+        return chunk_offset_ + position_;
     }
 
     /**
@@ -209,7 +251,7 @@ public:
      * @return Size in bytes
      */
     [[nodiscard]] std::size_t size() const noexcept {
-        return data_.size();
+        return size_;
     }
 
     /**
@@ -217,7 +259,7 @@ public:
      * @return Number of bytes remaining
      */
     [[nodiscard]] std::size_t remaining() const noexcept {
-        return data_.size() - position_;
+        return size_ - position();
     }
 
     /**
@@ -225,26 +267,28 @@ public:
      * @return true if more data is available
      */
     [[nodiscard]] bool has_more() const noexcept {
-        return position_ < data_.size();
+        return position() < size_;
     }
 
     /**
      * @brief Seeks to a specific position
      * @param pos Position to seek to
-     * @throws std::out_of_range if position is beyond buffer size
+     * @throws std::out_of_range if position is beyond buffer size (or,
+     *         for a chunked buffer, outside the current chunk)
      */
     void seek(std::size_t pos) {
-        if (pos > data_.size()) {
+        if (pos < chunk_offset_ || pos > chunk_offset_ + data_.size()) {
             throw std::out_of_range("Seek position out of range");
         }
-        position_ = pos;
+        position_ = pos - chunk_offset_;
     }
 
     /**
      * @brief Resets the read position to the beginning
+     * @throws std::out_of_range if a chunked reader has left its first chunk
      */
-    void reset() noexcept {
-        position_ = 0;
+    void reset() {
+        seek(0);
     }
 
     /**
@@ -253,15 +297,35 @@ public:
      * @throws std::runtime_error if skip would exceed buffer size
      */
     void skip(std::size_t count) {
-        if (position_ + count > data_.size()) {
+        if (count > remaining()) {
             throw std::runtime_error("Skip would exceed buffer size");
         }
+        while (position_ + count > data_.size()) {
+            count -= data_.size() - position_;
+            load_next_chunk();
+        }
         position_ += count;
     }
 
 private:
-    std::span<const uint8_t> data_; ///< Data buffer (view)
-    std::size_t position_;          ///< Current read position
+    /**
+     * @brief Moves on to the next chunk of a chunked buffer
+     * @throws std::runtime_error if the source has no more chunks
+     */
+    void load_next_chunk() {
+        chunk_offset_ += data_.size();
+        data_ = next_chunk_ ? next_chunk_() : std::span<const uint8_t>{};
+        position_ = 0;
+        if (data_.empty()) {
+            throw std::runtime_error("Not enough data to read");
+        }
+    }
+
+    std::span<const uint8_t> data_; ///< Data buffer (view; the current chunk)
+    std::size_t position_;          ///< Current read position in data_
+    std::size_t chunk_offset_;      ///< Position of data_ in the whole buffer
+    std::size_t size_;              ///< Total size of the buffer
+    ChunkSource next_chunk_;        ///< Source of further chunks (empty for one buffer)
 };
 
 } // namespace learnql::serialization
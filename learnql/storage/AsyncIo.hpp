@@ -0,0 +1,455 @@
+#ifndef LEARNQL_STORAGE_ASYNC_IO_HPP
+#define LEARNQL_STORAGE_ASYNC_IO_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cerrno>
+#include <climits>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+#include <sys/uio.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define LEARNQL_HAS_IO_URING 1
+#endif
+
+namespace learnql::storage {
+
+/**
+ * @brief How the storage engine issues batched page I/O
+ */
+enum class IoBackend : uint8_t {
+    SYNC = 0,        ///< One blocking system call per run of pages (no batching)
+    IO_URING = 1,    ///< Linux io_uring; falls back to THREAD_POOL where unavailable
+    THREAD_POOL = 2  ///< Worker threads issuing blocking calls side by side
+};
+
+/**
+ * @brief One positional transfer in a batch
+ * @details The buffers are read or written contiguously starting at offset,
+ *          like preadv/pwritev. At most IOV_MAX buffers per request.
+ */
+struct IoRequest {
+    bool write = false;                  ///< true for a write, false for a read
+    std::span<const iovec> buffers;      ///< Memory to transfer, in file order
+    uint64_t offset = 0;                 ///< File offset of the first byte
+    int64_t result = 0;                  ///< Bytes transferred, or -errno
+
+    /**
+     * @brief Total number of bytes the request covers
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        std::size_t total = 0;
+        for (const iovec& buffer : buffers) {
+            total += buffer.iov_len;
+        }
+        return total;
+    }
+};
+
+/**
+ * @brief Runs batches of positional reads and writes against one file
+ * @details A batch is handed to the backend in one go, so independent
+ *          transfers (runs of pages in different parts of the file) are in
+ *          flight together and the device can work on several at once.
+ *          run() returns once every request has finished; a request that
+ *          transferred only part of its bytes is completed with blocking
+ *          calls, so a short result means end of file or an error.
+ *
+ * Batches are serialized: the engine's flush and its readahead may call
+ * run() from different threads.
+ *
+ * Example:
+ * @code
+ * auto io = make_async_io(IoBackend::IO_URING, file.native_handle(), 64, 4);
+ * iovec first{page_a, 4096}, second{page_b, 4096};
+ * IoRequest requests[2] = {{false, {&first, 1}, 0}, {false, {&second, 1}, 4096 * 9}};
+ * io->run(requests);
+ * @endcode
+ */
+class AsyncIo {
+public:
+    /**
+     * @param fd Open file descriptor (not owned)
+     */
+    explicit AsyncIo(int fd) noexcept : fd_{fd}, run_mutex_{} {}
+
+    virtual ~AsyncIo() = default;
+
+    AsyncIo(const AsyncIo&) = delete;
+    AsyncIo& operator=(const AsyncIo&) = delete;
+
+    /**
+     * @brief Runs every request and waits for all of them
+     * @param requests Requests to run; each one's result is filled in
+     */
+    void run(std::span<IoRequest> requests) {
+        if (requests.empty()) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(run_mutex_);
+        execute(requests);
+
+        for (IoRequest& request : requests) {
+            if (request.result >= 0 && static_cast<std::size_t>(request.result) < request.size()) {
+                complete(request);
+            }
+        }
+    }
+
+    /**
+     * @brief Gets the name of the backend ("io_uring" or "thread pool")
+     */
+    [[nodiscard]] virtual const char* name() const noexcept = 0;
+
+protected:
+    /**
+     * @brief Starts every request and waits for all of them to finish
+     */
+    virtual void execute(std::span<IoRequest> requests) = 0;
+
+    /**
+     * @brief Finishes a request with blocking preadv/pwritev calls
+     * @details Continues after the request.result bytes already transferred;
+     *          stops early at end of file (reads) or on an error (-errno).
+     */
+    void complete(IoRequest& request) const {
+        std::vector<iovec> buffers(request.buffers.begin(), request.buffers.end());
+        auto done = static_cast<std::size_t>(request.result);
+
+        std::size_t first = 0;
+        auto skip = [&buffers, &first](std::size_t bytes) {
+            while (first < buffers.size() && bytes >= buffers[first].iov_len) {
+                bytes -= buffers[first].iov_len;
+                ++first;
+            }
+            if (bytes > 0) {
+                buffers[first].iov_base = static_cast<char*>(buffers[first].iov_base) + bytes;
+                buffers[first].iov_len -= bytes;
+            }
+        };
+        skip(done);
+
+        while (first < buffers.size()) {
+            int count = static_cast<int>(std::min<std::size_t>(buffers.size() - first, IOV_MAX));
+            auto offset = static_cast<off_t>(request.offset + done);
+            ssize_t n = request.write ? ::pwritev(fd_, buffers.data() + first, count, offset)
+                                      : ::preadv(fd_, buffers.data() + first, count, offset);
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                request.result = -errno;
+                return;
+            }
+            if (n == 0) {
+                break;  // End of file (reads only)
+            }
+            done += static_cast<std::size_t>(n);
+            skip(static_cast<std::size_t>(n));
+        }
+        request.result = static_cast<int64_t>(done);
+    }
+
+    int fd_;                 ///< File the requests refer to (not owned)
+
+private:
+    std::mutex run_mutex_;   ///< One batch at a time
+};
+
+/**
+ * @brief Emulates asynchronous I/O with a pool of threads doing blocking calls
+ * @details Portable fallback for io_uring. The calling thread works on the
+ *          batch too, so a pool of N threads keeps N + 1 requests in flight.
+ */
+class ThreadPoolIo final : public AsyncIo {
+public:
+    /**
+     * @param fd Open file descriptor (not owned)
+     * @param threads Number of worker threads (at least 1)
+     */
+    ThreadPoolIo(int fd, unsigned threads)
+        : AsyncIo(fd), mutex_{}, work_ready_{}, batch_done_{}, batch_{}, next_{0}, remaining_{0},
+          stop_{false}, workers_{} {
+        threads = std::max(threads, 1u);
+        workers_.reserve(threads);
+        for (unsigned i = 0; i < threads; ++i) {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ~ThreadPoolIo() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_ready_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    [[nodiscard]] const char* name() const noexcept override {
+        return "thread pool";
+    }
+
+protected:
+    void execute(std::span<IoRequest> requests) override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        batch_ = requests;
+        next_ = 0;
+        remaining_ = requests.size();
+        work_ready_.notify_all();
+
+        run_requests(lock);
+        batch_done_.wait(lock, [this] { return remaining_ == 0; });
+        batch_ = {};
+    }
+
+private:
+    /**
+     * @brief Takes requests from the current batch until none are left
+     * @param lock Hold on mutex_ (released while a request runs)
+     */
+    void run_requests(std::unique_lock<std::mutex>& lock) {
+        while (next_ < batch_.size()) {
+            IoRequest& request = batch_[next_++];
+            lock.unlock();
+            request.result = 0;
+            complete(request);
+            lock.lock();
+
+            if (--remaining_ == 0) {
+                batch_done_.notify_all();
+            }
+        }
+    }
+
+    void worker_loop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            work_ready_.wait(lock, [this] { return stop_ || next_ < batch_.size(); });
+            if (stop_) {
+                return;
+            }
+            run_requests(lock);
+        }
+    }
+
+    std::mutex mutex_;                    ///< Guards the batch state below
+    std::condition_variable work_ready_;  ///< A batch was posted (or stop_ set)
+    std::condition_variable batch_done_;  ///< The last request of the batch finished
+    std::span<IoRequest> batch_;          ///< Batch being run
+    std::size_t next_;                    ///< Next request to hand out
+    std::size_t remaining_;               ///< Requests not finished yet
+    bool stop_;                           ///< Tells the workers to exit
+    std::vector<std::thread> workers_;    ///< Worker threads
+};
+
+#ifdef LEARNQL_HAS_IO_URING
+/**
+ * @brief Linux io_uring backend, driven through the raw system calls
+ * @details One submission/completion ring pair per file. A batch is pushed
+ *          onto the submission ring as READV/WRITEV entries (up to the ring
+ *          size at a time) and handed to the kernel with one io_uring_enter,
+ *          which also waits for completions. No liburing needed.
+ */
+class UringIo final : public AsyncIo {
+public:
+    /**
+     * @brief Sets up a ring, or returns nullptr if the kernel refuses
+     *        (too old, or io_uring disabled by a sandbox)
+     * @param fd Open file descriptor (not owned)
+     * @param entries Ring size: requests in flight at once
+     */
+    [[nodiscard]] static std::unique_ptr<UringIo> create(int fd, unsigned entries) {
+        auto ring = std::unique_ptr<UringIo>(new UringIo(fd));
+        if (!ring->setup(std::max(entries, 1u))) {
+            return nullptr;
+        }
+        return ring;
+    }
+
+    ~UringIo() override {
+        if (sqes_ != nullptr) {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+            ::munmap(cq_ring_, cq_ring_size_);
+        }
+        if (sq_ring_ != nullptr) {
+            ::munmap(sq_ring_, sq_ring_size_);
+        }
+        if (ring_fd_ >= 0) {
+            ::close(ring_fd_);
+        }
+    }
+
+    [[nodiscard]] const char* name() const noexcept override {
+        return "io_uring";
+    }
+
+protected:
+    void execute(std::span<IoRequest> requests) override {
+        std::size_t next = 0;
+        std::size_t in_flight = 0;
+        for (IoRequest& request : requests) {
+            request.result = -ECANCELED;  // Overwritten by the completion
+        }
+
+        while (next < requests.size() || in_flight > 0) {
+            // Queue as many requests as the ring has room for
+            unsigned tail = *sq_tail_;
+            while (next < requests.size() && in_flight < entries_) {
+                IoRequest& request = requests[next];
+                io_uring_sqe& sqe = sqes_[tail & *sq_mask_];
+                std::memset(&sqe, 0, sizeof(sqe));
+                sqe.opcode = request.write ? IORING_OP_WRITEV : IORING_OP_READV;
+                sqe.fd = fd_;
+                sqe.addr = reinterpret_cast<uint64_t>(request.buffers.data());
+                sqe.len = static_cast<uint32_t>(request.buffers.size());
+                sqe.off = request.offset;
+                sqe.user_data = next;
+                ++tail;
+                ++next;
+                ++in_flight;
+            }
+            std::atomic_ref<unsigned>(*sq_tail_).store(tail, std::memory_order_release);
+
+            // Submit everything the kernel has not consumed yet and wait for one completion
+            unsigned pending = tail - std::atomic_ref<unsigned>(*sq_head_).load(std::memory_order_acquire);
+            long rc = ::syscall(__NR_io_uring_enter, ring_fd_, pending, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (rc < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                return;  // The ring is unusable; unfinished requests stay failed
+            }
+
+            // Reap completions
+            unsigned head = *cq_head_;
+            unsigned ready = std::atomic_ref<unsigned>(*cq_tail_).load(std::memory_order_acquire);
+            while (head != ready) {
+                const io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+                requests[cqe.user_data].result = cqe.res;
+                ++head;
+                --in_flight;
+            }
+            std::atomic_ref<unsigned>(*cq_head_).store(head, std::memory_order_release);
+        }
+    }
+
+private:
+    explicit UringIo(int fd) noexcept : AsyncIo(fd) {}
+
+    bool setup(unsigned entries) {
+        io_uring_params params{};
+        long fd = ::syscall(__NR_io_uring_setup, entries, &params);
+        if (fd < 0) {
+            return false;
+        }
+        ring_fd_ = static_cast<int>(fd);
+        entries_ = params.sq_entries;
+
+        sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+        }
+
+        sq_ring_ = map(sq_ring_size_, IORING_OFF_SQ_RING);
+        if (sq_ring_ == nullptr) {
+            return false;
+        }
+        cq_ring_ = single_mmap ? sq_ring_ : map(cq_ring_size_, IORING_OFF_CQ_RING);
+        if (cq_ring_ == nullptr) {
+            return false;
+        }
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+        if (sqes_ == nullptr) {
+            return false;
+        }
+
+        auto* sq = static_cast<uint8_t*>(sq_ring_);
+        auto* cq = static_cast<uint8_t*>(cq_ring_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        // Submission slot i always points at entry i
+        auto* array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        for (unsigned i = 0; i < params.sq_entries; ++i) {
+            array[i] = i;
+        }
+        return true;
+    }
+
+    [[nodiscard]] void* map(std::size_t size, off_t offset) const noexcept {
+        void* address = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+        return address == MAP_FAILED ? nullptr : address;
+    }
+
+    int ring_fd_ = -1;                     ///< io_uring instance
+    unsigned entries_ = 0;                 ///< Submission ring size
+    void* sq_ring_ = nullptr;              ///< Mapped submission ring
+    void* cq_ring_ = nullptr;              ///< Mapped completion ring (may equal sq_ring_)
+    std::size_t sq_ring_size_ = 0;
+    std::size_t cq_ring_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;         ///< Mapped submission entries
+    std::size_t sqes_size_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_mask_ = nullptr;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned* cq_mask_ = nullptr;
+    io_uring_cqe* cqes_ = nullptr;         ///< Completion entries
+};
+#endif
+
+/**
+ * @brief Creates the backend for a file
+ * @param backend Requested backend (SYNC returns nullptr)
+ * @param fd Open file descriptor (not owned)
+ * @param queue_depth io_uring ring size
+ * @param threads Thread pool size
+ * @return The backend, or nullptr for IoBackend::SYNC
+ * @details IO_URING falls back to the thread pool when the kernel does not
+ *          offer io_uring (or the platform is not Linux).
+ */
+[[nodiscard]] inline std::unique_ptr<AsyncIo> make_async_io(IoBackend backend, int fd,
+                                                           unsigned queue_depth, unsigned threads) {
+    switch (backend) {
+        case IoBackend::SYNC:
+            return nullptr;
+        case IoBackend::IO_URING:
+#ifdef LEARNQL_HAS_IO_URING
+            if (auto ring = UringIo::create(fd, queue_depth)) {
+                return ring;
+            }
+#endif
+            [[fallthrough]];
+        case IoBackend::THREAD_POOL:
+            return std::make_unique<ThreadPoolIo>(fd, threads);
+    }
+    return nullptr;
+}
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_ASYNC_IO_HPP
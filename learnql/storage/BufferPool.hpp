@@ -0,0 +1,733 @@
+#ifndef LEARNQL_STORAGE_BUFFER_POOL_HPP
+#define LEARNQL_STORAGE_BUFFER_POOL_HPP
+
+#include "Page.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <array>
+#include <unordered_map>
+#include <unordered_set>
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace learnql::storage {
+
+/**
+ * @brief Reader/writer latch protecting the contents of one buffer frame
+ * @details A single atomic word: -1 while held exclusively, otherwise the
+ *          number of shared holders. Waiters block with std::atomic::wait,
+ *          so an uncontended acquire or release is one atomic operation.
+ *
+ * Shared acquisition is re-entrant (a thread may hold several PageRefs to
+ * one page), but a thread must not request the exclusive latch on a page it
+ * already holds in any mode.
+ */
+class FrameLatch {
+public:
+    FrameLatch() noexcept : state_{0} {}
+
+    FrameLatch(const FrameLatch&) = delete;
+    FrameLatch& operator=(const FrameLatch&) = delete;
+
+    /**
+     * @brief Acquires the latch for reading (waits while a writer holds it)
+     */
+    void lock_shared() noexcept {
+        int32_t state = state_.load(std::memory_order_relaxed);
+        while (true) {
+            if (state < 0) {
+                state_.wait(state, std::memory_order_relaxed);
+                state = state_.load(std::memory_order_relaxed);
+            } else if (state_.compare_exchange_weak(state, state + 1, std::memory_order_acquire,
+                                                    std::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Acquires the latch for reading if no writer holds it
+     */
+    [[nodiscard]] bool try_lock_shared() noexcept {
+        int32_t state = state_.load(std::memory_order_relaxed);
+        while (state >= 0) {
+            if (state_.compare_exchange_weak(state, state + 1, std::memory_order_acquire,
+                                             std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Releases a shared hold
+     */
+    void unlock_shared() noexcept {
+        if (state_.fetch_sub(1, std::memory_order_release) == 1) {
+            state_.notify_all();
+        }
+    }
+
+    /**
+     * @brief Acquires the latch for writing (waits for every other holder)
+     */
+    void lock() noexcept {
+        int32_t state = 0;
+        while (!state_.compare_exchange_weak(state, -1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            if (state != 0) {
+                state_.wait(state, std::memory_order_relaxed);
+            }
+            state = 0;
+        }
+    }
+
+    /**
+     * @brief Acquires the latch for writing if nobody holds it
+     */
+    [[nodiscard]] bool try_lock() noexcept {
+        int32_t state = 0;
+        return state_.compare_exchange_strong(state, -1, std::memory_order_acquire, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Releases an exclusive hold
+     */
+    void unlock() noexcept {
+        state_.store(0, std::memory_order_release);
+        state_.notify_all();
+    }
+
+private:
+    std::atomic<int32_t> state_;  ///< -1 = exclusive, N > 0 = N readers, 0 = free
+};
+
+/**
+ * @brief How the buffer pool chooses which page to evict
+ */
+enum class ReplacementPolicy : uint8_t {
+    CLOCK,  ///< Second-chance CLOCK over all frames
+    TWO_Q   ///< CLOCK split into a probation and a protected part (scan resistant)
+};
+
+/**
+ * @brief Buffer pool with pin counts and CLOCK replacement
+ * @details Pages live in a frame array allocated at construction. A page
+ *          table maps page IDs to frames, and a CLOCK hand chooses victims.
+ *          resize() adds or removes frames at the end of the array (frames
+ *          are never moved, so references to them stay valid).
+ *
+ * CLOCK (second-chance) replacement:
+ * - Every access sets the frame's reference bit
+ * - The hand sweeps the frame array; a referenced frame has its bit cleared
+ *   and is skipped, an unreferenced unpinned frame becomes the victim
+ * - Pinned frames are never chosen
+ *
+ * Hot pages (e.g. the B+tree root) keep getting their reference bit set and
+ * survive sweeps, while pages touched once are evicted on the next pass.
+ * Victim selection is amortized O(1): each sweep step clears one bit, so the
+ * hand passes a frame at most twice before it can be chosen.
+ *
+ * Scan resistance (ReplacementPolicy::TWO_Q, the default): with plain CLOCK
+ * a table scan sets the bit of every page it reads, so a long scan sweeps
+ * out index and catalog pages that are only touched now and then. 2Q keeps
+ * those in a protected part instead:
+ * - A loaded page starts on probation, unreferenced (its load is its first
+ *   access); probation frames are evicted in CLOCK order, i.e. FIFO
+ * - A probation page accessed again before the hand reaches it is promoted
+ *   to the protected part, which the hand skips
+ * - Recently evicted probation pages are remembered (page IDs only, up to
+ *   half the capacity); one that is loaded again starts out protected
+ * - The protected part is held to 3/4 of the frames: while it is larger,
+ *   the hand gives its pages a second chance and then moves them back to
+ *   probation
+ *
+ * A scan's pages are read once, stay on probation and only recycle the
+ * probation frames, however long the scan is.
+ *
+ * Concurrency: the page table is split into PARTITION_COUNT partitions,
+ * each with its own mutex, and pin counts, reference bits and dirty flags
+ * are atomic. pin_resident() and unpin() may therefore run on any thread
+ * at any time: a cache hit touches one partition lock and the frame
+ * itself. Everything else (victim selection, assign/publish, resize) is
+ * called by the owner under its own lock. A frame leaves the page table
+ * (under its partition lock) only while its pin count is zero, and a
+ * loaded frame enters it only after its contents are complete, so a pinned
+ * frame always holds the page it was looked up for.
+ *
+ * Each frame also carries a FrameLatch that page guards hold while they
+ * use the page, so a reader never sees a write half done.
+ *
+ * The pool does no I/O itself. The owner (StorageEngine) writes back dirty
+ * victims and reads pages into the frames it is given.
+ *
+ * Example:
+ * @code
+ * BufferPool pool(64);
+ * auto frame_id = pool.lookup(page_id);
+ * if (frame_id == BufferPool::INVALID_FRAME) {
+ *     frame_id = pool.acquire_victim();   // write back if dirty, then load
+ *     pool.assign(frame_id, page_id);     // Pinned for the caller
+ *     // ... read the page into pool.frame(frame_id).page ...
+ *     pool.publish(frame_id);             // Now other threads can find it
+ * } else {
+ *     pool.pin(frame_id);
+ * }
+ * // ... use pool.frame(frame_id).page ...
+ * pool.unpin(frame_id, true);            // true = page was modified
+ * @endcode
+ */
+class BufferPool {
+public:
+    /**
+     * @brief Sentinel returned when a page is not resident
+     */
+    static constexpr std::size_t INVALID_FRAME = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * @brief Number of independently locked page table partitions
+     */
+    static constexpr std::size_t PARTITION_COUNT = 16;
+
+    /**
+     * @brief A single buffer frame
+     */
+    struct Frame {
+        /**
+         * @brief Creates an empty frame
+         */
+        Frame(std::size_t id, std::size_t page_size) : page(0, PageType::FREE, page_size), frame_id(id) {}
+
+        Page page;                             ///< Cached page contents
+        std::size_t frame_id;                  ///< Index of this frame in the pool
+        uint64_t page_id = 0;                  ///< Page held by this frame (valid only if in_use)
+        std::atomic<uint32_t> pin_count{0};    ///< Number of active users; pinned frames are never evicted
+        std::atomic<bool> dirty{false};        ///< Modified since last written to disk
+        std::atomic<bool> referenced{false};   ///< CLOCK reference bit
+        bool in_use = false;                   ///< Frame currently holds a page (owner's lock)
+        bool hot = false;                      ///< In the protected part (TWO_Q, owner's lock)
+        std::atomic<bool> logged{false};       ///< Current contents already appended to the WAL
+        std::atomic<bool> prefetched{false};   ///< Read ahead and not fetched since
+        FrameLatch latch;                      ///< Held by page guards while they use the page
+    };
+
+    /**
+     * @brief Creates a pool with a fixed number of frames
+     * @param capacity Number of frames (at least 1)
+     * @param page_size Size of the page held by each frame
+     * @param policy Replacement policy
+     */
+    explicit BufferPool(std::size_t capacity, std::size_t page_size = PAGE_SIZE,
+                        ReplacementPolicy policy = ReplacementPolicy::TWO_Q)
+        : frames_{},
+          partitions_{},
+          free_frames_{},
+          page_size_{page_size},
+          policy_{policy},
+          clock_hand_{0},
+          hot_count_{0},
+          ghosts_{},
+          ghost_order_{},
+          dirty_count_{0},
+          resident_count_{0} {
+        std::size_t frame_count = capacity == 0 ? 1 : capacity;
+        for (std::size_t i = 0; i < frame_count; ++i) {
+            frames_.emplace_back(i, page_size);
+        }
+
+        free_frames_.reserve(frames_.size());
+
+        // Hand out low frame numbers first
+        for (std::size_t i = frames_.size(); i > 0; --i) {
+            free_frames_.push_back(i - 1);
+        }
+    }
+
+    // Disable copy and move (frames are owned, guards point into them)
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+    BufferPool(BufferPool&&) = delete;
+    BufferPool& operator=(BufferPool&&) = delete;
+
+    /**
+     * @brief Finds the frame holding a page
+     * @param page_id Page to look up
+     * @return Frame index, or INVALID_FRAME if the page is not resident
+     */
+    [[nodiscard]] std::size_t lookup(uint64_t page_id) const {
+        const Partition& partition = partition_for(page_id);
+        std::lock_guard<std::mutex> lock(partition.mutex);
+        auto it = partition.frames.find(page_id);
+        return it != partition.frames.end() ? it->second->frame_id : INVALID_FRAME;
+    }
+
+    /**
+     * @brief Pins a resident page (safe on any thread)
+     * @param page_id Page to look up
+     * @return The pinned frame, or nullptr if the page is not resident or
+     *         was read ahead and not fetched yet (the owner counts those)
+     *
+     * Each hit is counted in its partition (see hit_count()).
+     */
+    [[nodiscard]] Frame* pin_resident(uint64_t page_id) {
+        Partition& partition = partition_for(page_id);
+        std::lock_guard<std::mutex> lock(partition.mutex);
+        auto it = partition.frames.find(page_id);
+        if (it == partition.frames.end() || it->second->prefetched.load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        Frame& f = *it->second;
+        f.pin_count.fetch_add(1, std::memory_order_acquire);
+        // Only this partition's lock holder writes the counter, so no atomic increment is needed
+        partition.hits.store(partition.hits.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        if (!f.referenced.load(std::memory_order_relaxed)) {
+            f.referenced.store(true, std::memory_order_relaxed);
+        }
+        return &f;
+    }
+
+    /**
+     * @brief Gets a frame by index
+     */
+    [[nodiscard]] Frame& frame(std::size_t frame_id) noexcept {
+        return frames_[frame_id];
+    }
+
+    /**
+     * @brief Gets a frame by index (const)
+     */
+    [[nodiscard]] const Frame& frame(std::size_t frame_id) const noexcept {
+        return frames_[frame_id];
+    }
+
+    /**
+     * @brief Takes a frame for a new page
+     * @return Index of a free frame, or of an unpinned victim chosen by CLOCK
+     * @throws std::runtime_error if every frame is pinned
+     *
+     * A victim is removed from the page table before it is returned, so no
+     * other thread can pin it. It keeps its old page ID, contents and dirty
+     * flag: if it is dirty the caller writes it back before calling
+     * assign(), and calls restore() if that fails.
+     */
+    [[nodiscard]] std::size_t acquire_victim() {
+        if (!free_frames_.empty()) {
+            std::size_t frame_id = free_frames_.back();
+            free_frames_.pop_back();
+            return frame_id;
+        }
+
+        // Two full sweeps are enough for CLOCK: the first clears every
+        // reference bit. 2Q may need two more to age protected pages out.
+        std::size_t sweeps = policy_ == ReplacementPolicy::CLOCK ? 2 : 4;
+        for (std::size_t step = 0; step < sweeps * frames_.size(); ++step) {
+            std::size_t candidate = clock_hand_;
+            clock_hand_ = (clock_hand_ + 1) % frames_.size();
+
+            Frame& f = frames_[candidate];
+            if (f.pin_count.load(std::memory_order_relaxed) > 0) {
+                continue;
+            }
+            if (f.hot) {
+                // Protected pages age only while that part is over its share,
+                // or once a whole sweep found nothing else to evict
+                if (hot_count_ > hot_limit() || step >= frames_.size()) {
+                    if (f.referenced.load(std::memory_order_relaxed)) {
+                        f.referenced.store(false, std::memory_order_relaxed);  // Second chance
+                    } else {
+                        f.hot = false;  // Back to probation
+                        --hot_count_;
+                    }
+                }
+                continue;
+            }
+            if (f.referenced.load(std::memory_order_relaxed)) {
+                f.referenced.store(false, std::memory_order_relaxed);
+                if (policy_ == ReplacementPolicy::TWO_Q) {
+                    f.hot = true;  // Accessed again while on probation
+                    ++hot_count_;
+                }
+                continue;
+            }
+            if (f.in_use && unpublish_if_unpinned(f, false)) {
+                if (policy_ == ReplacementPolicy::TWO_Q) {
+                    remember_evicted(f.page_id);
+                }
+                return candidate;
+            }
+        }
+
+        throw std::runtime_error("Buffer pool exhausted: all frames are pinned");
+    }
+
+    /**
+     * @brief Puts a victim back in the page table (its write-back failed)
+     * @param frame_id Frame returned by acquire_victim()
+     */
+    void restore(std::size_t frame_id) {
+        Frame& f = frames_[frame_id];
+        if (f.in_use) {
+            publish(frame_id);
+        } else {
+            free_frames_.push_back(frame_id);
+        }
+    }
+
+    /**
+     * @brief Binds a frame to a page, dropping whatever it held before
+     * @param frame_id Frame returned by acquire_victim()
+     * @param page_id Page the frame now holds
+     *
+     * The frame starts clean and pinned once for the caller. With CLOCK it
+     * starts referenced; with TWO_Q it starts on probation, unreferenced,
+     * unless the page was evicted recently (then it starts protected). It
+     * is not in the page table yet: the caller fills it, then calls
+     * publish() (or invalidate() if loading failed). Its page contents are
+     * left untouched - the caller loads or overwrites them.
+     */
+    void assign(std::size_t frame_id, uint64_t page_id) {
+        release(frame_id);
+
+        Frame& f = frames_[frame_id];
+        f.page_id = page_id;
+        f.in_use = true;
+        f.referenced.store(policy_ == ReplacementPolicy::CLOCK, std::memory_order_relaxed);
+        if (policy_ == ReplacementPolicy::TWO_Q && ghosts_.erase(page_id) > 0) {
+            f.hot = true;  // Re-read soon after eviction: not a one-off access
+            ++hot_count_;
+        }
+        f.pin_count.store(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Makes an assigned frame visible to lookups
+     * @param frame_id Frame whose contents are complete
+     */
+    void publish(std::size_t frame_id) {
+        Frame& f = frames_[frame_id];
+        Partition& partition = partition_for(f.page_id);
+        std::lock_guard<std::mutex> lock(partition.mutex);
+        partition.frames[f.page_id] = &f;
+        resident_count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns an assigned frame to the free list (e.g. after a failed load)
+     * @param frame_id Frame to invalidate (pinned only by the caller, if at all)
+     */
+    void invalidate(std::size_t frame_id) {
+        Frame& f = frames_[frame_id];
+        if (!f.in_use) {
+            return;
+        }
+        unpublish(f);
+        release(frame_id);
+        free_frames_.push_back(frame_id);
+    }
+
+    /**
+     * @brief Drops a resident page unless someone has it pinned
+     * @param frame_id Frame to free
+     * @param discard_dirty true to drop a dirty page too (e.g. a freed page)
+     * @return false if the frame is pinned, or dirty and discard_dirty is
+     *         false (it is left alone)
+     *
+     * Dirty pages are refused by default because another thread may have
+     * modified the page after the caller wrote it back.
+     */
+    bool try_evict(std::size_t frame_id, bool discard_dirty = false) {
+        Frame& f = frames_[frame_id];
+        if (!f.in_use) {
+            return true;
+        }
+        if (!unpublish_if_unpinned(f, !discard_dirty)) {
+            return false;
+        }
+        release(frame_id);
+        free_frames_.push_back(frame_id);
+        return true;
+    }
+
+    /**
+     * @brief Pins a frame so it cannot be evicted (owner's lock held)
+     */
+    void pin(std::size_t frame_id) noexcept {
+        Frame& f = frames_[frame_id];
+        f.pin_count.fetch_add(1, std::memory_order_acquire);
+        f.referenced.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Releases one pin on a frame
+     * @param frame_id Frame to unpin
+     * @param dirty true if the caller modified the page
+     */
+    void unpin(std::size_t frame_id, bool dirty) {
+        unpin(frames_[frame_id], dirty);
+    }
+
+    /**
+     * @brief Releases one pin on a frame (safe on any thread)
+     * @param f Frame to unpin
+     * @param dirty true if the caller modified the page
+     *
+     * The dirty flag is set before the pin is dropped, so the frame cannot
+     * be evicted clean in between.
+     */
+    void unpin(Frame& f, bool dirty) {
+        if (f.pin_count.load(std::memory_order_relaxed) == 0) {
+            throw std::logic_error("Unpinning a frame that is not pinned");
+        }
+        if (dirty) {
+            mark_dirty(f);
+        }
+        f.pin_count.fetch_sub(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Marks a frame as modified
+     */
+    void mark_dirty(std::size_t frame_id) noexcept {
+        mark_dirty(frames_[frame_id]);
+    }
+
+    /**
+     * @brief Marks a frame as modified (safe on any thread)
+     */
+    void mark_dirty(Frame& f) noexcept {
+        f.logged.store(false, std::memory_order_relaxed);  // The new contents still need a log record
+        if (!f.dirty.exchange(true, std::memory_order_acq_rel)) {
+            dirty_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Marks a frame as written back
+     */
+    void mark_clean(std::size_t frame_id) noexcept {
+        Frame& f = frames_[frame_id];
+        if (f.dirty.exchange(false, std::memory_order_acq_rel)) {
+            dirty_count_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Changes the number of frames
+     * @param capacity New number of frames (at least 1)
+     * @return The number of frames afterwards
+     *
+     * Growing appends free frames. Shrinking removes frames from the end of
+     * the array and stops at the first one still holding a page or pinned:
+     * the caller writes back and evicts the tail frames first (see
+     * tail_frame()).
+     */
+    std::size_t resize(std::size_t capacity) {
+        capacity = capacity == 0 ? 1 : capacity;
+        while (frames_.size() < capacity) {
+            free_frames_.push_back(frames_.size());
+            frames_.emplace_back(frames_.size(), page_size_);
+        }
+
+        bool removed = false;
+        while (frames_.size() > capacity && !frames_.back().in_use &&
+               frames_.back().pin_count.load(std::memory_order_relaxed) == 0) {
+            std::size_t frame_id = frames_.size() - 1;
+            free_frames_.erase(std::find(free_frames_.begin(), free_frames_.end(), frame_id));
+            frames_.pop_back();
+            removed = true;
+        }
+        if (removed && clock_hand_ >= frames_.size()) {
+            clock_hand_ = 0;
+        }
+        return frames_.size();
+    }
+
+    /**
+     * @brief Gets the replacement policy
+     */
+    [[nodiscard]] ReplacementPolicy policy() const noexcept {
+        return policy_;
+    }
+
+    /**
+     * @brief Number of frames in the protected part (TWO_Q)
+     */
+    [[nodiscard]] std::size_t hot_count() const noexcept {
+        return hot_count_;
+    }
+
+    /**
+     * @brief Gets the index of the frame resize() would remove next
+     */
+    [[nodiscard]] std::size_t tail_frame() const noexcept {
+        return frames_.size() - 1;
+    }
+
+    /**
+     * @brief Number of frames
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept {
+        return frames_.size();
+    }
+
+    /**
+     * @brief Number of frames currently holding a page
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return resident_count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of dirty frames
+     */
+    [[nodiscard]] std::size_t dirty_count() const noexcept {
+        return dirty_count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of hits taken by pin_resident() since the last reset_hit_count()
+     */
+    [[nodiscard]] uint64_t hit_count() const noexcept {
+        uint64_t hits = 0;
+        for (const Partition& partition : partitions_) {
+            hits += partition.hits.load(std::memory_order_relaxed);
+        }
+        return hits;
+    }
+
+    /**
+     * @brief Zeroes the hit counters
+     */
+    void reset_hit_count() {
+        for (Partition& partition : partitions_) {
+            std::lock_guard<std::mutex> lock(partition.mutex);
+            partition.hits.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Calls fn(frame_id, frame) for every frame holding a page
+     */
+    template<typename Fn>
+    void for_each_resident(Fn&& fn) {
+        for (std::size_t i = 0; i < frames_.size(); ++i) {
+            if (frames_[i].in_use) {
+                fn(i, frames_[i]);
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief One independently locked slice of the page table
+     */
+    struct alignas(64) Partition {
+        mutable std::mutex mutex;                         ///< Guards frames
+        std::unordered_map<uint64_t, Frame*> frames;      ///< Page ID -> frame
+        std::atomic<uint64_t> hits{0};                    ///< pin_resident() hits (written under mutex)
+    };
+
+    [[nodiscard]] Partition& partition_for(uint64_t page_id) noexcept {
+        return partitions_[page_id % PARTITION_COUNT];
+    }
+
+    [[nodiscard]] const Partition& partition_for(uint64_t page_id) const noexcept {
+        return partitions_[page_id % PARTITION_COUNT];
+    }
+
+    /**
+     * @brief Removes a frame from the page table if nobody has it pinned
+     * @param f Frame to remove
+     * @param require_clean true to also refuse a dirty frame
+     * @return false if the frame was refused (it stays in the table)
+     *
+     * Pins are only taken under the partition lock, and a frame is marked
+     * dirty before its pin is dropped, so once the checks pass here no other
+     * thread can pin or dirty the frame.
+     */
+    bool unpublish_if_unpinned(Frame& f, bool require_clean) {
+        Partition& partition = partition_for(f.page_id);
+        std::lock_guard<std::mutex> lock(partition.mutex);
+        if (f.pin_count.load(std::memory_order_acquire) > 0 ||
+            (require_clean && f.dirty.load(std::memory_order_acquire))) {
+            return false;
+        }
+        auto it = partition.frames.find(f.page_id);
+        if (it != partition.frames.end() && it->second == &f) {
+            partition.frames.erase(it);
+            resident_count_.fetch_sub(1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Largest number of protected frames before they start aging out
+     */
+    [[nodiscard]] std::size_t hot_limit() const noexcept {
+        return frames_.size() - frames_.size() / 4;
+    }
+
+    /**
+     * @brief Remembers an evicted probation page (the oldest entries are forgotten)
+     */
+    void remember_evicted(uint64_t page_id) {
+        if (!ghosts_.insert(page_id).second) {
+            return;
+        }
+        ghost_order_.push_back(page_id);
+        while (ghost_order_.size() > std::max<std::size_t>(frames_.size() / 2, 1)) {
+            ghosts_.erase(ghost_order_.front());  // Usually a no-op if the page was loaded again
+            ghost_order_.pop_front();
+        }
+    }
+
+    /**
+     * @brief Removes a frame from the page table (if it is there)
+     */
+    void unpublish(Frame& f) {
+        Partition& partition = partition_for(f.page_id);
+        std::lock_guard<std::mutex> lock(partition.mutex);
+        auto it = partition.frames.find(f.page_id);
+        if (it != partition.frames.end() && it->second == &f) {
+            partition.frames.erase(it);
+            resident_count_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Resets a frame's state (it must not be in the page table)
+     */
+    void release(std::size_t frame_id) {
+        Frame& f = frames_[frame_id];
+        mark_clean(frame_id);
+        if (f.hot) {
+            f.hot = false;
+            --hot_count_;
+        }
+        f.in_use = false;
+        f.referenced.store(false, std::memory_order_relaxed);
+        f.logged.store(false, std::memory_order_relaxed);
+        f.prefetched.store(false, std::memory_order_relaxed);
+        f.pin_count.store(0, std::memory_order_relaxed);
+    }
+
+    std::deque<Frame> frames_;                             ///< Frame array (grows and shrinks at the end)
+    std::array<Partition, PARTITION_COUNT> partitions_;    ///< Page table, split by page ID
+    std::vector<std::size_t> free_frames_;                 ///< Frames not holding any page
+    std::size_t page_size_;                                ///< Size of each frame's page
+    ReplacementPolicy policy_;                             ///< How victims are chosen
+    std::size_t clock_hand_;                               ///< CLOCK sweep position
+    std::size_t hot_count_;                                ///< Frames in the protected part (TWO_Q)
+    std::unordered_set<uint64_t> ghosts_;                  ///< Recently evicted probation pages (TWO_Q)
+    std::deque<uint64_t> ghost_order_;                     ///< ghosts_ in eviction order, oldest first
+    std::atomic<std::size_t> dirty_count_;                 ///< Number of dirty frames
+    std::atomic<std::size_t> resident_count_;              ///< Number of frames in the page table
+};
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_BUFFER_POOL_HPP
@@ -0,0 +1,226 @@
+#ifndef LEARNQL_STORAGE_CRC32C_HPP
+#define LEARNQL_STORAGE_CRC32C_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#include <nmmintrin.h>
+#define LEARNQL_CRC32C_SSE42 1
+#define LEARNQL_CRC32C_TARGET __attribute__((target("sse4.2")))
+#elif defined(_M_X64) && defined(_MSC_VER)
+#include <intrin.h>
+#include <nmmintrin.h>
+#define LEARNQL_CRC32C_SSE42 1
+#define LEARNQL_CRC32C_TARGET
+#endif
+
+namespace learnql::storage {
+
+namespace detail {
+
+/**
+ * @brief CRC32C polynomial (bit-reflected)
+ */
+constexpr uint32_t CRC32C_POLYNOMIAL = 0x82F63B78u;
+
+/**
+ * @brief Builds the slicing-by-8 tables at compile time
+ * @details tables[0] is the classic byte-at-a-time table; tables[k] advances
+ *          a byte that is followed by k more bytes.
+ */
+constexpr std::array<std::array<uint32_t, 256>, 8> make_crc32c_tables() {
+    std::array<std::array<uint32_t, 256>, 8> tables{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1u) ? CRC32C_POLYNOMIAL : 0u);
+        }
+        tables[0][i] = crc;
+    }
+    for (std::size_t k = 1; k < 8; ++k) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t previous = tables[k - 1][i];
+            tables[k][i] = (previous >> 8) ^ tables[0][previous & 0xFFu];
+        }
+    }
+    return tables;
+}
+
+inline constexpr auto CRC32C_TABLES = make_crc32c_tables();
+
+} // namespace detail
+
+/**
+ * @brief Computes CRC32C with slicing-by-8 tables (portable)
+ * @param data Bytes to checksum
+ * @param size Number of bytes
+ * @param crc CRC of the preceding bytes, to continue a running checksum
+ */
+[[nodiscard]] inline uint32_t crc32c_portable(const void* data, std::size_t size, uint32_t crc = 0) noexcept {
+    const auto& tables = detail::CRC32C_TABLES;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    crc = ~crc;
+
+    if constexpr (std::endian::native == std::endian::little) {
+        while (size >= 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes, sizeof(word));
+            word ^= crc;
+            crc = tables[7][word & 0xFF] ^ tables[6][(word >> 8) & 0xFF] ^
+                  tables[5][(word >> 16) & 0xFF] ^ tables[4][(word >> 24) & 0xFF] ^
+                  tables[3][(word >> 32) & 0xFF] ^ tables[2][(word >> 40) & 0xFF] ^
+                  tables[1][(word >> 48) & 0xFF] ^ tables[0][word >> 56];
+            bytes += 8;
+            size -= 8;
+        }
+    }
+
+    while (size-- > 0) {
+        crc = tables[0][(crc ^ *bytes++) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+#ifdef LEARNQL_CRC32C_SSE42
+namespace detail {
+
+/**
+ * @brief Bytes per stream in one round of the 3-way interleaved loop
+ */
+constexpr std::size_t CRC32C_STRIDE = 1024;
+
+/**
+ * @brief Advances a raw CRC state over a run of zero bytes
+ */
+[[nodiscard]] LEARNQL_CRC32C_TARGET inline uint32_t crc32c_sse42_zeros(uint32_t state, std::size_t size) noexcept {
+    uint64_t wide = state;
+    for (std::size_t i = 0; i < size; i += 8) {
+        wide = _mm_crc32_u64(wide, 0);
+    }
+    return static_cast<uint32_t>(wide);
+}
+
+/**
+ * @brief Tables that advance a raw CRC state over CRC32C_STRIDE zero bytes
+ * @details The CRC register update is linear, so shifting a state is the XOR
+ *          of the shifts of its four bytes. Built once, on first use.
+ */
+[[nodiscard]] inline const std::array<std::array<uint32_t, 256>, 4>& crc32c_stride_shift() {
+    static const auto tables = [] {
+        std::array<std::array<uint32_t, 256>, 4> result{};
+        for (uint32_t k = 0; k < 4; ++k) {
+            for (uint32_t b = 0; b < 256; ++b) {
+                result[k][b] = crc32c_sse42_zeros(b << (8 * k), CRC32C_STRIDE);
+            }
+        }
+        return result;
+    }();
+    return tables;
+}
+
+} // namespace detail
+
+/**
+ * @brief Computes CRC32C with the SSE4.2 crc32 instruction
+ * @details Only call this when crc32c_hardware_available() is true.
+ *          The instruction has a 3-cycle latency but can start every cycle,
+ *          so large inputs run three independent streams side by side and
+ *          merge them with crc32c_stride_shift().
+ */
+[[nodiscard]] LEARNQL_CRC32C_TARGET inline uint32_t crc32c_sse42(const void* data, std::size_t size,
+                                                                uint32_t crc = 0) noexcept {
+    constexpr std::size_t stride = detail::CRC32C_STRIDE;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    uint64_t state = static_cast<uint32_t>(~crc);
+
+    if (size >= 3 * stride) {
+        const auto& shift = detail::crc32c_stride_shift();
+        auto advance = [&shift](uint64_t value) -> uint64_t {
+            return shift[0][value & 0xFF] ^ shift[1][(value >> 8) & 0xFF] ^
+                   shift[2][(value >> 16) & 0xFF] ^ shift[3][(value >> 24) & 0xFF];
+        };
+
+        while (size >= 3 * stride) {
+            uint64_t first = state;
+            uint64_t second = 0;
+            uint64_t third = 0;
+            for (std::size_t i = 0; i < stride; i += 8) {
+                uint64_t words[3];
+                std::memcpy(&words[0], bytes + i, 8);
+                std::memcpy(&words[1], bytes + stride + i, 8);
+                std::memcpy(&words[2], bytes + 2 * stride + i, 8);
+                first = _mm_crc32_u64(first, words[0]);
+                second = _mm_crc32_u64(second, words[1]);
+                third = _mm_crc32_u64(third, words[2]);
+            }
+            state = advance(advance(first) ^ second) ^ third;
+            bytes += 3 * stride;
+            size -= 3 * stride;
+        }
+    }
+
+    while (size >= 8) {
+        uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        state = _mm_crc32_u64(state, word);
+        bytes += 8;
+        size -= 8;
+    }
+
+    auto narrow = static_cast<uint32_t>(state);
+    while (size-- > 0) {
+        narrow = _mm_crc32_u8(narrow, *bytes++);
+    }
+    return ~narrow;
+}
+#endif
+
+/**
+ * @brief Checks whether this CPU computes CRC32C in hardware
+ */
+[[nodiscard]] inline bool crc32c_hardware_available() noexcept {
+#if defined(LEARNQL_CRC32C_SSE42) && defined(_MSC_VER) && !defined(__clang__)
+    static const bool available = [] {
+        int info[4];
+        __cpuid(info, 1);
+        return (info[2] & (1 << 20)) != 0;
+    }();
+    return available;
+#elif defined(LEARNQL_CRC32C_SSE42)
+    static const bool available = __builtin_cpu_supports("sse4.2");
+    return available;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Computes CRC32C (Castagnoli) using the fastest implementation for this CPU
+ * @param data Bytes to checksum
+ * @param size Number of bytes
+ * @param crc CRC of the preceding bytes, to continue a running checksum
+ * @details On x86-64 CPUs with SSE4.2 the crc32 instruction handles 8 bytes
+ *          per step; elsewhere slicing-by-8 tables are used.
+ *
+ * Example:
+ * @code
+ * uint32_t crc = crc32c(page.raw_data(), page.size());
+ * crc = crc32c(more_bytes, n, crc);  // Continue over more data
+ * @endcode
+ */
+[[nodiscard]] inline uint32_t crc32c(const void* data, std::size_t size, uint32_t crc = 0) noexcept {
+#ifdef LEARNQL_CRC32C_SSE42
+    if (crc32c_hardware_available()) {
+        return crc32c_sse42(data, size, crc);
+    }
+#endif
+    return crc32c_portable(data, size, crc);
+}
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_CRC32C_HPP
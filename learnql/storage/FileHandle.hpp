@@ -0,0 +1,345 @@
+#ifndef LEARNQL_STORAGE_FILE_HANDLE_HPP
+#define LEARNQL_STORAGE_FILE_HANDLE_HPP
+
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+#include <algorithm>
+#include <climits>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+namespace learnql::storage {
+
+/**
+ * @brief RAII wrapper around a POSIX file descriptor with positional I/O
+ * @details The file is opened once and every read/write carries its own
+ *          offset (pread/pwrite and the vectored preadv/pwritev), so there is
+ *          no shared seek position and no open/close per operation.
+ *
+ * Features:
+ * - Move-only ownership of the descriptor
+ * - Partial transfers and EINTR are retried transparently
+ * - Vectored I/O for writing several pages in one system call
+ *
+ * Example:
+ * @code
+ * FileHandle file("data.db", FileHandle::create_flags());
+ * file.write_at(buffer, 4096, 0);
+ * file.read_at(buffer, 4096, 4096 * 7);
+ * @endcode
+ */
+class FileHandle {
+public:
+    /**
+     * @brief Flags for opening an existing file for reading only
+     */
+    [[nodiscard]] static constexpr int read_only_flags() noexcept {
+        return O_RDONLY | O_CLOEXEC;
+    }
+
+    /**
+     * @brief Flags for opening an existing file for reading and writing
+     */
+    [[nodiscard]] static constexpr int read_write_flags() noexcept {
+        return O_RDWR | O_CLOEXEC;
+    }
+
+    /**
+     * @brief Flags for creating (or truncating) a file for reading and writing
+     */
+    [[nodiscard]] static constexpr int create_flags() noexcept {
+        return O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC;
+    }
+
+    /**
+     * @brief Checks whether direct_flags() can bypass the OS page cache here
+     */
+    [[nodiscard]] static constexpr bool supports_direct_io() noexcept {
+#ifdef O_DIRECT
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Adds O_DIRECT to a set of open flags (where the platform has it)
+     * @details Reads and writes then go straight between the device and the
+     *          caller's buffer, skipping the OS page cache. Buffers, offsets
+     *          and sizes must all be multiples of the device's logical block
+     *          size (see PAGE_ALIGNMENT), or transfers fail with EINVAL.
+     */
+    [[nodiscard]] static constexpr int direct_flags(int flags) noexcept {
+#ifdef O_DIRECT
+        return flags | O_DIRECT;
+#else
+        return flags;
+#endif
+    }
+
+    /**
+     * @brief Creates a closed handle
+     */
+    FileHandle() noexcept : fd_{-1}, path_{} {}
+
+    /**
+     * @brief Opens a file
+     * @param path Path to the file
+     * @param flags open(2) flags
+     * @param mode Permission bits used when the file is created
+     * @throws std::runtime_error if the file cannot be opened
+     */
+    FileHandle(const std::string& path, int flags, mode_t mode = 0644)
+        : fd_{-1}, path_{path} {
+        do {
+            fd_ = ::open(path.c_str(), flags, mode);
+        } while (fd_ < 0 && errno == EINTR);
+
+        if (fd_ < 0) {
+            throw_errno("Cannot open file: " + path_);
+        }
+    }
+
+    /**
+     * @brief Destructor - closes the descriptor
+     */
+    ~FileHandle() {
+        close();
+    }
+
+    // Disable copy (descriptor is unique)
+    FileHandle(const FileHandle&) = delete;
+    FileHandle& operator=(const FileHandle&) = delete;
+
+    // Allow move
+    FileHandle(FileHandle&& other) noexcept
+        : fd_{std::exchange(other.fd_, -1)}, path_{std::move(other.path_)} {}
+
+    FileHandle& operator=(FileHandle&& other) noexcept {
+        if (this != &other) {
+            close();
+            fd_ = std::exchange(other.fd_, -1);
+            path_ = std::move(other.path_);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Checks whether the handle owns an open descriptor
+     */
+    [[nodiscard]] bool is_open() const noexcept {
+        return fd_ >= 0;
+    }
+
+    /**
+     * @brief Gets the raw descriptor (for mmap, fallocate, etc.)
+     */
+    [[nodiscard]] int native_handle() const noexcept {
+        return fd_;
+    }
+
+    /**
+     * @brief Closes the descriptor (no-op if already closed)
+     */
+    void close() noexcept {
+        if (fd_ >= 0) {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    /**
+     * @brief Reads up to size bytes at an absolute offset
+     * @param dest Destination buffer
+     * @param size Number of bytes to read
+     * @param offset File offset to read from
+     * @return Number of bytes read (less than size only at end of file)
+     * @throws std::runtime_error on I/O error
+     */
+    std::size_t read_at(void* dest, std::size_t size, uint64_t offset) const {
+        auto* out = static_cast<char*>(dest);
+        std::size_t done = 0;
+
+        while (done < size) {
+            ssize_t n = ::pread(fd_, out + done, size - done, static_cast<off_t>(offset + done));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw_errno("Read failed on " + path_);
+            }
+            if (n == 0) {
+                break;  // End of file
+            }
+            done += static_cast<std::size_t>(n);
+        }
+
+        return done;
+    }
+
+    /**
+     * @brief Writes exactly size bytes at an absolute offset
+     * @param src Source buffer
+     * @param size Number of bytes to write
+     * @param offset File offset to write to
+     * @throws std::runtime_error on I/O error
+     */
+    void write_at(const void* src, std::size_t size, uint64_t offset) {
+        const auto* in = static_cast<const char*>(src);
+        std::size_t done = 0;
+
+        while (done < size) {
+            ssize_t n = ::pwrite(fd_, in + done, size - done, static_cast<off_t>(offset + done));
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw_errno("Write failed on " + path_);
+            }
+            done += static_cast<std::size_t>(n);
+        }
+    }
+
+    /**
+     * @brief Scatter-reads into several buffers starting at an absolute offset
+     * @param buffers Buffers to fill, in file order (modified while reading)
+     * @param offset File offset of the first byte
+     * @return Total number of bytes read (short only at end of file)
+     * @throws std::runtime_error on I/O error
+     */
+    std::size_t readv_at(std::span<iovec> buffers, uint64_t offset) const {
+        return transfer_vectored(buffers, offset, false);
+    }
+
+    /**
+     * @brief Gather-writes several buffers contiguously at an absolute offset
+     * @param buffers Buffers to write, in file order (modified while writing)
+     * @param offset File offset of the first byte
+     * @throws std::runtime_error on I/O error
+     */
+    void writev_at(std::span<iovec> buffers, uint64_t offset) {
+        transfer_vectored(buffers, offset, true);
+    }
+
+    /**
+     * @brief Reserves disk blocks for a byte range without changing the file size
+     * @param offset Start of the range
+     * @param length Length of the range in bytes
+     * @return true if the blocks are reserved; false where the platform or
+     *         file system cannot do it (writes then allocate as they go)
+     * @details Uses fallocate(FALLOC_FL_KEEP_SIZE) on Linux: the range gets
+     *          contiguous extents now, and later writes into it only move
+     *          the end of file instead of allocating blocks piece by piece.
+     */
+    bool reserve(uint64_t offset, uint64_t length) noexcept {
+#if defined(__linux__) && defined(FALLOC_FL_KEEP_SIZE)
+        int rc;
+        do {
+            rc = ::fallocate(fd_, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), static_cast<off_t>(length));
+        } while (rc < 0 && errno == EINTR);
+        return rc == 0;
+#else
+        (void)offset;
+        (void)length;
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Flushes file data to stable storage (fdatasync)
+     * @throws std::runtime_error on failure
+     */
+    void sync() {
+        int rc;
+        do {
+            rc = ::fdatasync(fd_);
+        } while (rc < 0 && errno == EINTR);
+
+        if (rc < 0) {
+            throw_errno("Sync failed on " + path_);
+        }
+    }
+
+    /**
+     * @brief Gets the current file size in bytes
+     * @throws std::runtime_error on failure
+     */
+    [[nodiscard]] uint64_t size() const {
+        struct stat st {};
+        if (::fstat(fd_, &st) < 0) {
+            throw_errno("Cannot stat " + path_);
+        }
+        return static_cast<uint64_t>(st.st_size);
+    }
+
+    /**
+     * @brief Gets the path the handle was opened with
+     */
+    [[nodiscard]] const std::string& path() const noexcept {
+        return path_;
+    }
+
+private:
+    /**
+     * @brief Shared loop for preadv/pwritev with partial-transfer handling
+     */
+    std::size_t transfer_vectored(std::span<iovec> buffers, uint64_t offset, bool write) const {
+        std::size_t done = 0;
+        std::size_t first = 0;
+
+        while (first < buffers.size()) {
+            int count = static_cast<int>(std::min<std::size_t>(buffers.size() - first, IOV_MAX));
+            ssize_t n = write
+                ? ::pwritev(fd_, buffers.data() + first, count, static_cast<off_t>(offset + done))
+                : ::preadv(fd_, buffers.data() + first, count, static_cast<off_t>(offset + done));
+
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                throw_errno(std::string(write ? "Write" : "Read") + " failed on " + path_);
+            }
+            if (n == 0) {
+                break;  // End of file (reads only)
+            }
+
+            done += static_cast<std::size_t>(n);
+
+            // Skip fully transferred buffers and trim a partially transferred one
+            auto remaining = static_cast<std::size_t>(n);
+            while (first < buffers.size() && remaining >= buffers[first].iov_len) {
+                remaining -= buffers[first].iov_len;
+                ++first;
+            }
+            if (remaining > 0) {
+                buffers[first].iov_base = static_cast<char*>(buffers[first].iov_base) + remaining;
+                buffers[first].iov_len -= remaining;
+            }
+        }
+
+        return done;
+    }
+
+    /**
+     * @brief Throws std::runtime_error carrying the current errno text
+     */
+    [[noreturn]] static void throw_errno(const std::string& what) {
+        throw std::runtime_error(what + ": " + std::generic_category().message(errno));
+    }
+
+    int fd_;            ///< Owned descriptor (-1 when closed)
+    std::string path_;  ///< Path for error messages
+};
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_FILE_HANDLE_HPP
@@ -0,0 +1,378 @@
+#ifndef LEARNQL_STORAGE_FREE_SPACE_MAP_HPP
+#define LEARNQL_STORAGE_FREE_SPACE_MAP_HPP
+
+#include "Page.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <span>
+#include <bit>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace learnql::storage {
+
+/**
+ * @brief In-memory allocation bitmap of a database file
+ * @details One bit per page (1 = allocated). Pages are divided into groups
+ *          of pages_per_group() pages; each group's bits are stored in one
+ *          page of the file:
+ *
+ * - Group 0 lives in page 0, after the database metadata
+ * - Group g >= 1 lives in a FREE_SPACE_MAP page, normally the first page of
+ *   the group (page g * pages_per_group())
+ * - In both, the bitmap starts at data offset BITMAP_OFFSET
+ *
+ * The whole bitmap is kept in memory, so allocating and freeing never read
+ * a page. Changed groups are marked dirty; StorageEngine writes them back
+ * together with the rest of the metadata at flush time.
+ *
+ * Allocation is first-fit from the lowest page that may be free, so freed
+ * pages are reused before the file grows, and allocate(n) returns n
+ * contiguous pages (e.g. for a sequential run of table or index pages).
+ *
+ * Example:
+ * @code
+ * FreeSpaceMap map(4096);
+ * map.set_end(1);                      // Page 0 exists
+ * uint64_t first = map.allocate(8);    // Pages first..first+7
+ * map.release(first + 3);
+ * @endcode
+ */
+class FreeSpaceMap {
+public:
+    /**
+     * @brief Data offset of the bitmap in page 0 and in map pages
+     * @details Page 0 keeps its metadata fields below this offset.
+     */
+    static constexpr std::size_t BITMAP_OFFSET = 128;
+
+    /**
+     * @brief Creates an empty map (only page 0 allocated)
+     * @param page_size Page size of the database
+     */
+    explicit FreeSpaceMap(std::size_t page_size = PAGE_SIZE)
+        : pages_per_group_{(page_size - sizeof(PageHeader) - BITMAP_OFFSET) * 8},
+          bits_{},
+          map_pages_{0},
+          dirty_groups_{},
+          end_{1},
+          free_hint_{1} {
+        set_bit(0);
+    }
+
+    /**
+     * @brief Number of pages whose bits fit in one map page
+     */
+    [[nodiscard]] uint64_t pages_per_group() const noexcept {
+        return pages_per_group_;
+    }
+
+    /**
+     * @brief Number of bytes of bitmap stored per group
+     */
+    [[nodiscard]] std::size_t bytes_per_group() const noexcept {
+        return pages_per_group_ / 8;
+    }
+
+    /**
+     * @brief Gets the group that tracks a page
+     */
+    [[nodiscard]] uint64_t group_of(uint64_t page_id) const noexcept {
+        return page_id / pages_per_group_;
+    }
+
+    /**
+     * @brief Number of groups that have a map page (group 0 included)
+     */
+    [[nodiscard]] uint64_t group_count() const noexcept {
+        return map_pages_.size();
+    }
+
+    /**
+     * @brief Gets the page that stores a group's bits (0 = page 0)
+     */
+    [[nodiscard]] uint64_t map_page(uint64_t group) const noexcept {
+        return group < map_pages_.size() ? map_pages_[group] : 0;
+    }
+
+    /**
+     * @brief One past the highest page ever allocated (the file's page count)
+     */
+    [[nodiscard]] uint64_t end() const noexcept {
+        return end_;
+    }
+
+    /**
+     * @brief Checks whether a page is allocated
+     */
+    [[nodiscard]] bool is_allocated(uint64_t page_id) const noexcept {
+        return test_bit(page_id);
+    }
+
+    /**
+     * @brief Checks whether a page stores bitmap bits (page 0 or a map page)
+     */
+    [[nodiscard]] bool is_map_page(uint64_t page_id) const noexcept {
+        return page_id == 0 || std::find(map_pages_.begin() + 1, map_pages_.end(), page_id) != map_pages_.end();
+    }
+
+    /**
+     * @brief Allocates contiguous pages
+     * @param count Number of pages (at least 1)
+     * @return ID of the first page
+     * @details Map pages for groups reached for the first time are
+     *          allocated as well (and are never part of the returned run).
+     */
+    uint64_t allocate(uint64_t count) {
+        if (count == 0) {
+            throw std::invalid_argument("Cannot allocate zero pages");
+        }
+
+        uint64_t first = find_free_run(count);
+        for (uint64_t page_id = first; page_id < first + count; ++page_id) {
+            mark_allocated(page_id);
+        }
+        if (first == free_hint_) {
+            free_hint_ = first + count;
+        }
+        return first;
+    }
+
+    /**
+     * @brief Frees a page
+     * @throws std::invalid_argument for page 0, a map page or a page that is not allocated
+     */
+    void release(uint64_t page_id) {
+        if (is_map_page(page_id)) {
+            throw std::invalid_argument("Cannot free metadata page " + std::to_string(page_id));
+        }
+        if (!test_bit(page_id)) {
+            throw std::invalid_argument("Page " + std::to_string(page_id) + " is not allocated");
+        }
+        clear_bit(page_id);
+        mark_dirty(group_of(page_id));
+        free_hint_ = std::min(free_hint_, page_id);
+    }
+
+    /**
+     * @brief Sets the page count read from page 0
+     */
+    void set_end(uint64_t end) noexcept {
+        end_ = std::max<uint64_t>(end, 1);
+    }
+
+    /**
+     * @brief Records where a group's bits are stored (while loading)
+     */
+    void set_map_page(uint64_t group, uint64_t page_id) {
+        if (map_pages_.size() <= group) {
+            map_pages_.resize(group + 1, 0);
+        }
+        map_pages_[group] = page_id;
+    }
+
+    /**
+     * @brief Loads one group's bits from its map page
+     */
+    void load_group(uint64_t group, std::span<const uint8_t> bytes) {
+        ensure_words((group + 1) * pages_per_group_);
+        std::memcpy(bits_.data() + group * words_per_group(), bytes.data(),
+                    std::min(bytes.size(), bytes_per_group()));
+        free_hint_ = 1;
+    }
+
+    /**
+     * @brief Copies one group's bits into its map page
+     */
+    void store_group(uint64_t group, std::span<uint8_t> bytes) const {
+        std::size_t size = std::min(bytes.size(), bytes_per_group());
+        std::size_t first_word = group * words_per_group();
+        std::size_t available = first_word < bits_.size()
+            ? std::min(size, (bits_.size() - first_word) * sizeof(uint64_t)) : 0;
+
+        std::memset(bytes.data(), 0, size);
+        if (available > 0) {
+            std::memcpy(bytes.data(), bits_.data() + first_word, available);
+        }
+    }
+
+    /**
+     * @brief Rebuilds the map for a file that used the old linked free list
+     * @param free_pages Pages found on the old free list
+     * @details Every page below end() not on the list is allocated; map pages
+     *          are created for all groups the file spans.
+     */
+    void rebuild(const std::vector<uint64_t>& free_pages) {
+        uint64_t end = end_;
+        for (uint64_t page_id = 0; page_id < end; ++page_id) {
+            set_bit(page_id);
+        }
+        for (uint64_t page_id : free_pages) {
+            if (page_id != 0 && page_id < end) {
+                clear_bit(page_id);
+            }
+        }
+        free_hint_ = 1;
+        for (uint64_t group = 1; group <= group_of(end - 1); ++group) {
+            create_map_page(group);
+        }
+        mark_dirty(0);
+    }
+
+    /**
+     * @brief Checks whether any group changed since the last clear_dirty()
+     */
+    [[nodiscard]] bool is_dirty() const noexcept {
+        return std::find(dirty_groups_.begin(), dirty_groups_.end(), true) != dirty_groups_.end();
+    }
+
+    /**
+     * @brief Checks whether a group changed since the last clear_dirty()
+     */
+    [[nodiscard]] bool is_dirty(uint64_t group) const noexcept {
+        return group < dirty_groups_.size() && dirty_groups_[group];
+    }
+
+    /**
+     * @brief Marks every group as written back
+     */
+    void clear_dirty() noexcept {
+        std::fill(dirty_groups_.begin(), dirty_groups_.end(), false);
+    }
+
+private:
+    [[nodiscard]] std::size_t words_per_group() const noexcept {
+        return pages_per_group_ / 64;
+    }
+
+    void ensure_words(uint64_t page_count) {
+        std::size_t words = (page_count + 63) / 64;
+        if (bits_.size() < words) {
+            bits_.resize(words, 0);
+        }
+    }
+
+    [[nodiscard]] bool test_bit(uint64_t page_id) const noexcept {
+        std::size_t word = page_id / 64;
+        return word < bits_.size() && (bits_[word] >> (page_id % 64)) & 1u;
+    }
+
+    void set_bit(uint64_t page_id) {
+        ensure_words(page_id + 1);
+        bits_[page_id / 64] |= uint64_t{1} << (page_id % 64);
+    }
+
+    void clear_bit(uint64_t page_id) noexcept {
+        if (page_id / 64 < bits_.size()) {
+            bits_[page_id / 64] &= ~(uint64_t{1} << (page_id % 64));
+        }
+    }
+
+    void mark_dirty(uint64_t group) {
+        if (dirty_groups_.size() <= group) {
+            dirty_groups_.resize(group + 1, false);
+        }
+        dirty_groups_[group] = true;
+    }
+
+    /**
+     * @brief Checks whether a page can be handed out
+     * @details The first page of a group without a map page is held back
+     *          for that group's map page.
+     */
+    [[nodiscard]] bool is_taken(uint64_t page_id) const noexcept {
+        if (test_bit(page_id)) {
+            return true;
+        }
+        uint64_t group = group_of(page_id);
+        return page_id % pages_per_group_ == 0 && map_page(group) == 0;
+    }
+
+    /**
+     * @brief Finds the first page at or after page_id that can be handed out
+     */
+    [[nodiscard]] uint64_t next_free(uint64_t page_id) const noexcept {
+        while (true) {
+            std::size_t word = page_id / 64;
+            if (word < bits_.size()) {
+                // Skip whole words of allocated pages
+                uint64_t taken = bits_[word] | ((uint64_t{1} << (page_id % 64)) - 1);
+                if (taken == ~uint64_t{0}) {
+                    page_id = (word + 1) * 64;
+                    continue;
+                }
+                page_id = word * 64 + static_cast<uint64_t>(std::countr_one(taken));
+            }
+            if (!is_taken(page_id)) {
+                return page_id;
+            }
+            ++page_id;
+        }
+    }
+
+    /**
+     * @brief First-fit search for count consecutive free pages
+     */
+    [[nodiscard]] uint64_t find_free_run(uint64_t count) const noexcept {
+        uint64_t first = free_hint_;
+        while (true) {
+            first = next_free(first);
+            uint64_t last = first + 1;
+            while (last - first < count && !is_taken(last)) {
+                ++last;
+            }
+            if (last - first == count) {
+                return first;
+            }
+            first = last + 1;
+        }
+    }
+
+    /**
+     * @brief Sets a page's bit, creating its group's map page if needed
+     */
+    void mark_allocated(uint64_t page_id) {
+        uint64_t group = group_of(page_id);
+        if (group > 0 && map_page(group) == 0) {
+            create_map_page(group);
+        }
+        set_bit(page_id);
+        mark_dirty(group);
+        end_ = std::max(end_, page_id + 1);
+    }
+
+    /**
+     * @brief Places the map page of a group (its first page when free)
+     */
+    void create_map_page(uint64_t group) {
+        if (map_page(group) != 0) {
+            return;
+        }
+
+        uint64_t page_id = group * pages_per_group_;
+        if (test_bit(page_id)) {
+            // Files converted from the free list may already use that page
+            page_id = next_free(end_);
+        }
+
+        set_map_page(group, page_id);
+        mark_allocated(page_id);
+
+        // The previous group's page links to this one
+        mark_dirty(group - 1);
+    }
+
+    uint64_t pages_per_group_;          ///< Pages tracked by one map page
+    std::vector<uint64_t> bits_;        ///< One bit per page, 1 = allocated
+    std::vector<uint64_t> map_pages_;   ///< Map page per group (group 0 = page 0)
+    std::vector<bool> dirty_groups_;    ///< Groups changed since the last write-back
+    uint64_t end_;                      ///< One past the highest allocated page
+    uint64_t free_hint_;                ///< No free page below this one
+};
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_FREE_SPACE_MAP_HPP
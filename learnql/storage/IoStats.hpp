@@ -0,0 +1,94 @@
+#ifndef LEARNQL_STORAGE_IO_STATS_HPP
+#define LEARNQL_STORAGE_IO_STATS_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+namespace learnql::storage {
+
+/**
+ * @brief Counters describing the storage engine's disk traffic
+ * @details Maintained by StorageEngine and returned by get_io_stats().
+ *
+ * Flushes sort dirty pages by page ID and merge adjacent pages into runs,
+ * each written with a single vectored write. The run counters show how
+ * sequential a workload's write-back is: after a bulk load the average run
+ * length should be close to the number of pages flushed.
+ *
+ * The cache counters size StorageOptions::cache_size: a low hit ratio, or
+ * many dirty evictions (foreground writes of a victim page), means the
+ * working set does not fit.
+ */
+struct IoStats {
+    uint64_t pages_read = 0;        ///< Pages read from the file
+    uint64_t pages_written = 0;     ///< Pages written to the file (all paths)
+    uint64_t flushes = 0;           ///< Batched write-backs of the dirty set
+    uint64_t flushed_pages = 0;     ///< Pages written by batched write-backs
+    uint64_t flush_runs = 0;        ///< Contiguous runs (one vectored write each)
+    uint64_t max_run_length = 0;    ///< Longest run written so far, in pages
+    uint64_t commits = 0;           ///< commit() calls
+    uint64_t checkpoints = 0;       ///< WAL checkpoints
+    uint64_t wal_records = 0;       ///< Page images appended to the WAL
+    uint64_t wal_bytes = 0;         ///< Bytes appended to the WAL
+    uint64_t wal_syncs = 0;         ///< WAL fsyncs (one per group commit)
+    uint64_t redo_pages = 0;        ///< Pages restored from the WAL at open
+    uint64_t writer_pages = 0;      ///< Pages written by the background writer
+    uint64_t foreground_stalls = 0; ///< Times a caller hit the hard dirty limit
+    uint64_t async_batches = 0;     ///< Batches submitted to the asynchronous I/O backend
+    uint64_t prefetched_pages = 0;  ///< Pages read ahead (prefetch_pages() or sequential readahead)
+    uint64_t readahead_windows = 0; ///< Sequential readahead windows issued by the engine
+    uint64_t prefetch_hits = 0;     ///< Fetches served by a page that was read ahead
+    uint64_t prefetch_misses = 0;   ///< Read-ahead pages evicted before any fetch used them
+    uint64_t file_reservations = 0; ///< fallocate calls that reserved space for growth
+    uint64_t compressed_bytes = 0;  ///< Bytes stored for the pages written (compressed databases)
+    uint64_t cache_hits = 0;        ///< Page fetches served by the buffer pool
+    uint64_t cache_misses = 0;      ///< Page fetches that read the file
+    uint64_t evictions = 0;         ///< Pages dropped to make room for another page
+    uint64_t dirty_evictions = 0;   ///< Evicted pages that had to be written back first
+    uint64_t bytes_read = 0;        ///< Bytes read from the database file
+    uint64_t bytes_written = 0;     ///< Bytes written to the database file (the WAL not included)
+    uint64_t flush_nanos = 0;       ///< Time spent in batched write-backs
+
+    /**
+     * @brief Average number of pages per flushed run
+     */
+    [[nodiscard]] double average_run_length() const noexcept {
+        return flush_runs > 0 ? static_cast<double>(flushed_pages) / static_cast<double>(flush_runs) : 0.0;
+    }
+
+    /**
+     * @brief Page bytes written per byte stored (compressed databases)
+     * @param page_size Page size of the database
+     */
+    [[nodiscard]] double compression_ratio(std::size_t page_size) const noexcept {
+        return compressed_bytes > 0
+            ? static_cast<double>(pages_written * page_size) / static_cast<double>(compressed_bytes) : 0.0;
+    }
+
+    /**
+     * @brief Fraction of page fetches served by the buffer pool
+     */
+    [[nodiscard]] double hit_ratio() const noexcept {
+        uint64_t fetches = cache_hits + cache_misses;
+        return fetches > 0 ? static_cast<double>(cache_hits) / static_cast<double>(fetches) : 0.0;
+    }
+
+    /**
+     * @brief Average duration of a batched write-back in milliseconds
+     */
+    [[nodiscard]] double average_flush_ms() const noexcept {
+        return flushes > 0 ? static_cast<double>(flush_nanos) / 1e6 / static_cast<double>(flushes) : 0.0;
+    }
+
+    /**
+     * @brief Fraction of read-ahead pages that were used before eviction
+     */
+    [[nodiscard]] double prefetch_hit_ratio() const noexcept {
+        uint64_t settled = prefetch_hits + prefetch_misses;
+        return settled > 0 ? static_cast<double>(prefetch_hits) / static_cast<double>(settled) : 0.0;
+    }
+};
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_IO_STATS_HPP
@@ -0,0 +1,253 @@
+#ifndef LEARNQL_STORAGE_LZ_CODEC_HPP
+#define LEARNQL_STORAGE_LZ_CODEC_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @file LzCodec.hpp
+ * @brief Small LZ77 block codec used for page compression
+ *
+ * The format follows the LZ4 block layout. A block is a series of sequences:
+ * - token byte: high nibble = literal count, low nibble = match length - 4
+ *   (a nibble of 15 continues in extra bytes, each adding 0-255; a byte
+ *   below 255 ends the run)
+ * - the literal bytes
+ * - a 2-byte little-endian match offset, back into the output (1-65535)
+ * - extra match length bytes
+ *
+ * The last sequence may stop after its literals. The decoder is told the
+ * exact output size and checks every read and write against the buffers,
+ * so a corrupt block fails cleanly instead of overrunning memory.
+ *
+ * Compression is greedy with a 4096-entry hash table of 4-byte sequences:
+ * fast, and good on the long zero runs and repeated strings of a page.
+ */
+
+namespace learnql::storage {
+
+namespace detail {
+
+constexpr std::size_t LZ_MIN_MATCH = 4;
+constexpr std::size_t LZ_MAX_OFFSET = 65535;
+constexpr unsigned LZ_HASH_BITS = 12;
+
+[[nodiscard]] inline uint32_t lz_read32(const uint8_t* p) noexcept {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+[[nodiscard]] inline uint32_t lz_hash(uint32_t sequence) noexcept {
+    return (sequence * 2654435761u) >> (32 - LZ_HASH_BITS);
+}
+
+/**
+ * @brief Writes the continuation bytes of a length above 14
+ * @return Position after the bytes, or nullptr if they do not fit
+ */
+[[nodiscard]] inline uint8_t* lz_write_length(uint8_t* op, const uint8_t* end, std::size_t length) noexcept {
+    while (length >= 255) {
+        if (op >= end) {
+            return nullptr;
+        }
+        *op++ = 255;
+        length -= 255;
+    }
+    if (op >= end) {
+        return nullptr;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+/**
+ * @brief Reads the continuation bytes of a length nibble of 15
+ * @return false if the input ends first
+ */
+[[nodiscard]] inline bool lz_read_length(const uint8_t*& ip, const uint8_t* end, std::size_t& length) noexcept {
+    uint8_t byte;
+    do {
+        if (ip >= end) {
+            return false;
+        }
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+/**
+ * @brief Emits one sequence (literals, then an optional match)
+ * @return Position after the sequence, or nullptr if it does not fit
+ */
+[[nodiscard]] inline uint8_t* lz_emit(uint8_t* op, const uint8_t* end, const uint8_t* literals,
+                                      std::size_t literal_count, std::size_t offset, std::size_t match_length) noexcept {
+    if (op >= end) {
+        return nullptr;
+    }
+    uint8_t* token = op++;
+    std::size_t match_code = match_length > 0 ? match_length - LZ_MIN_MATCH : 0;
+    *token = static_cast<uint8_t>((std::min<std::size_t>(literal_count, 15) << 4) |
+                                  std::min<std::size_t>(match_code, 15));
+
+    if (literal_count >= 15 && !(op = lz_write_length(op, end, literal_count - 15))) {
+        return nullptr;
+    }
+    if (static_cast<std::size_t>(end - op) < literal_count) {
+        return nullptr;
+    }
+    if (literal_count > 0) {
+        std::memcpy(op, literals, literal_count);
+        op += literal_count;
+    }
+
+    if (match_length == 0) {
+        return op;
+    }
+    if (end - op < 2) {
+        return nullptr;
+    }
+    *op++ = static_cast<uint8_t>(offset & 0xFF);
+    *op++ = static_cast<uint8_t>(offset >> 8);
+    if (match_code >= 15 && !(op = lz_write_length(op, end, match_code - 15))) {
+        return nullptr;
+    }
+    return op;
+}
+
+} // namespace detail
+
+/**
+ * @brief Compresses a block
+ * @param src Input bytes
+ * @param size Number of input bytes
+ * @param dst Output buffer
+ * @param capacity Size of the output buffer
+ * @return Compressed size, or 0 if it would exceed capacity (the caller
+ *         then stores the block uncompressed)
+ */
+[[nodiscard]] inline std::size_t lz_compress(const void* src, std::size_t size, void* dst,
+                                             std::size_t capacity) noexcept {
+    using namespace detail;
+
+    const auto* in = static_cast<const uint8_t*>(src);
+    auto* out = static_cast<uint8_t*>(dst);
+    const uint8_t* out_end = out + capacity;
+    uint8_t* op = out;
+
+    std::array<uint32_t, std::size_t{1} << LZ_HASH_BITS> table{};  // Position + 1 (0 = empty)
+    std::size_t anchor = 0;
+    std::size_t pos = 0;
+
+    while (pos + LZ_MIN_MATCH <= size) {
+        uint32_t sequence = lz_read32(in + pos);
+        uint32_t& slot = table[lz_hash(sequence)];
+        std::size_t candidate = slot;
+        slot = static_cast<uint32_t>(pos + 1);
+
+        if (candidate == 0 || pos - (candidate - 1) > LZ_MAX_OFFSET || lz_read32(in + candidate - 1) != sequence) {
+            ++pos;
+            continue;
+        }
+        --candidate;
+
+        std::size_t length = LZ_MIN_MATCH;
+        while (pos + length < size && in[candidate + length] == in[pos + length]) {
+            ++length;
+        }
+
+        op = lz_emit(op, out_end, in + anchor, pos - anchor, pos - candidate, length);
+        if (!op) {
+            return 0;
+        }
+        pos += length;
+        anchor = pos;
+
+        // Let the end of the match seed later matches
+        if (pos >= 2 && pos + 2 <= size) {
+            table[lz_hash(lz_read32(in + pos - 2))] = static_cast<uint32_t>(pos - 1);
+        }
+    }
+
+    if (anchor < size || op == out) {
+        op = lz_emit(op, out_end, in + anchor, size - anchor, 0, 0);
+        if (!op) {
+            return 0;
+        }
+    }
+    return static_cast<std::size_t>(op - out);
+}
+
+/**
+ * @brief Decompresses a block produced by lz_compress()
+ * @param src Compressed bytes
+ * @param size Number of compressed bytes
+ * @param dst Output buffer
+ * @param expected Exact decompressed size (the output buffer's size)
+ * @return true if the block was well formed and filled exactly expected bytes
+ */
+[[nodiscard]] inline bool lz_decompress(const void* src, std::size_t size, void* dst,
+                                        std::size_t expected) noexcept {
+    using namespace detail;
+
+    const auto* ip = static_cast<const uint8_t*>(src);
+    const uint8_t* in_end = ip + size;
+    auto* out = static_cast<uint8_t*>(dst);
+    uint8_t* op = out;
+    const uint8_t* out_end = out + expected;
+
+    while (ip < in_end) {
+        uint8_t token = *ip++;
+
+        std::size_t literal_count = token >> 4;
+        if (literal_count == 15 && !lz_read_length(ip, in_end, literal_count)) {
+            return false;
+        }
+        if (static_cast<std::size_t>(in_end - ip) < literal_count ||
+            static_cast<std::size_t>(out_end - op) < literal_count) {
+            return false;
+        }
+        if (literal_count > 0) {
+            std::memcpy(op, ip, literal_count);
+            ip += literal_count;
+            op += literal_count;
+        }
+
+        if (ip == in_end) {
+            break;  // Last sequence: literals only
+        }
+
+        if (in_end - ip < 2) {
+            return false;
+        }
+        std::size_t offset = static_cast<std::size_t>(ip[0]) | (static_cast<std::size_t>(ip[1]) << 8);
+        ip += 2;
+        std::size_t match_length = token & 15;
+        if (match_length == 15 && !lz_read_length(ip, in_end, match_length)) {
+            return false;
+        }
+        match_length += LZ_MIN_MATCH;
+
+        if (offset == 0 || offset > static_cast<std::size_t>(op - out) ||
+            static_cast<std::size_t>(out_end - op) < match_length) {
+            return false;
+        }
+
+        // Byte by byte: the match may overlap the bytes it produces
+        const uint8_t* match = op - offset;
+        for (std::size_t i = 0; i < match_length; ++i) {
+            op[i] = match[i];
+        }
+        op += match_length;
+    }
+
+    return op == out_end;
+}
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_LZ_CODEC_HPP
@@ -0,0 +1,119 @@
+#ifndef LEARNQL_STORAGE_MAPPED_FILE_HPP
+#define LEARNQL_STORAGE_MAPPED_FILE_HPP
+
+#include "FileHandle.hpp"
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <cerrno>
+#include <cstdint>
+#include <cstddef>
+
+#include <sys/mman.h>
+
+namespace learnql::storage {
+
+/**
+ * @brief RAII read-only memory mapping of a whole file
+ * @details The mapping is shared (MAP_SHARED), so every process mapping the
+ *          same file reads the same physical pages from the OS page cache -
+ *          no per-process copy and no read() system call per page.
+ *
+ * Example:
+ * @code
+ * FileHandle file("data.db", FileHandle::read_only_flags());
+ * MappedFile map(file);
+ * const auto* bytes = map.data() + 4096 * 7;   // Page 7, straight from the page cache
+ * @endcode
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Creates an empty mapping
+     */
+    MappedFile() noexcept : data_{nullptr}, size_{0} {}
+
+    /**
+     * @brief Maps the current contents of an open file
+     * @param file File to map (may be closed afterwards - the mapping stays valid)
+     * @throws std::runtime_error if the file cannot be mapped
+     */
+    explicit MappedFile(const FileHandle& file)
+        : data_{nullptr}, size_{static_cast<std::size_t>(file.size())} {
+        if (size_ == 0) {
+            return;  // mmap rejects empty mappings
+        }
+
+        void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, file.native_handle(), 0);
+        if (addr == MAP_FAILED) {
+            throw std::runtime_error("Cannot map file " + file.path() + ": " +
+                                     std::generic_category().message(errno));
+        }
+        data_ = static_cast<const uint8_t*>(addr);
+    }
+
+    /**
+     * @brief Destructor - unmaps the file
+     */
+    ~MappedFile() {
+        unmap();
+    }
+
+    // Disable copy (mapping is unique)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Allow move
+    MappedFile(MappedFile&& other) noexcept
+        : data_{std::exchange(other.data_, nullptr)}, size_{std::exchange(other.size_, 0)} {}
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Checks whether a file is mapped
+     */
+    [[nodiscard]] bool is_mapped() const noexcept {
+        return data_ != nullptr;
+    }
+
+    /**
+     * @brief Gets the start of the mapping
+     */
+    [[nodiscard]] const uint8_t* data() const noexcept {
+        return data_;
+    }
+
+    /**
+     * @brief Gets the mapped length in bytes
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    /**
+     * @brief Releases the mapping (no-op if nothing is mapped)
+     */
+    void unmap() noexcept {
+        if (data_) {
+            ::munmap(const_cast<uint8_t*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    const uint8_t* data_;  ///< Start of the mapping (nullptr when empty)
+    std::size_t size_;     ///< Mapped length in bytes
+};
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_MAPPED_FILE_HPP
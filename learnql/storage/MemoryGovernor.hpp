@@ -0,0 +1,453 @@
+#ifndef LEARNQL_STORAGE_MEMORY_GOVERNOR_HPP
+#define LEARNQL_STORAGE_MEMORY_GOVERNOR_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace learnql::storage {
+
+class MemoryGovernor;
+
+/**
+ * @brief One cache's share of a MemoryGovernor budget
+ * @details Handed out by MemoryGovernor::register_cache(). The cache checks
+ *          limit_units() when it decides whether to evict, and reports each
+ *          lookup with record_hit() or record_miss(). The governor uses
+ *          those counts to move memory between caches. The limit and the
+ *          counters are atomic, so a cache never takes the governor's lock
+ *          on its lookup path; it picks up a new limit on its next miss.
+ */
+class MemoryBudget {
+public:
+    /**
+     * @brief Creates a share (use MemoryGovernor::register_cache())
+     * @param name Name shown in MemoryGovernor::shares()
+     * @param unit_bytes Size of one cached item (a frame, a node)
+     * @param floor_units Items the cache keeps however little it is used
+     * @param miss_cost Relative cost of one miss (1.0 = a page read from the file)
+     * @param limit_bytes Initial share
+     * @param governor Governor told about misses
+     */
+    MemoryBudget(std::string name, std::size_t unit_bytes, std::size_t floor_units, double miss_cost,
+                 std::size_t limit_bytes, std::weak_ptr<MemoryGovernor> governor)
+        : name_{std::move(name)},
+          unit_bytes_{std::max<std::size_t>(unit_bytes, 1)},
+          floor_units_{std::max<std::size_t>(floor_units, 1)},
+          miss_cost_{miss_cost},
+          limit_bytes_{limit_bytes},
+          hits_{0},
+          misses_{0},
+          seen_misses_{0},
+          governor_{std::move(governor)} {}
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    /**
+     * @brief Gets the cache's name
+     */
+    [[nodiscard]] const std::string& name() const noexcept {
+        return name_;
+    }
+
+    /**
+     * @brief Gets the size of one cached item in bytes
+     */
+    [[nodiscard]] std::size_t unit_bytes() const noexcept {
+        return unit_bytes_;
+    }
+
+    /**
+     * @brief Gets the smallest share, in items
+     */
+    [[nodiscard]] std::size_t floor_units() const noexcept {
+        return floor_units_;
+    }
+
+    /**
+     * @brief Gets the relative cost of one miss
+     */
+    [[nodiscard]] double miss_cost() const noexcept {
+        return miss_cost_;
+    }
+
+    /**
+     * @brief Gets the current share in bytes
+     */
+    [[nodiscard]] std::size_t limit_bytes() const noexcept {
+        return limit_bytes_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the current share as a number of items (at least the floor)
+     */
+    [[nodiscard]] std::size_t limit_units() const noexcept {
+        return std::max(limit_bytes() / unit_bytes_, floor_units_);
+    }
+
+    /**
+     * @brief Counts a lookup served from the cache
+     */
+    void record_hit() noexcept {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Counts a lookup that had to load its item (may trigger a rebalance)
+     */
+    inline void record_miss();
+
+    /**
+     * @brief Gets the lookups served from the cache so far
+     */
+    [[nodiscard]] uint64_t hits() const noexcept {
+        return hits_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the lookups that missed so far
+     */
+    [[nodiscard]] uint64_t misses() const noexcept {
+        return misses_.load(std::memory_order_relaxed);
+    }
+
+private:
+    friend class MemoryGovernor;
+
+    std::string name_;                      ///< Name shown in reports
+    std::size_t unit_bytes_;                ///< Bytes per cached item
+    std::size_t floor_units_;               ///< Smallest share in items
+    double miss_cost_;                      ///< Relative cost of one miss
+    std::atomic<std::size_t> limit_bytes_;  ///< Current share (written by the governor)
+    std::atomic<uint64_t> hits_;            ///< Lookups served from the cache
+    std::atomic<uint64_t> misses_;          ///< Lookups that loaded their item
+    uint64_t seen_misses_;                  ///< misses_ at the last rebalance (governor lock)
+    std::weak_ptr<MemoryGovernor> governor_; ///< Governor told about misses
+};
+
+/**
+ * @brief Divides one memory budget between a database's caches
+ * @details Owned by Database (StorageOptions::memory_budget_bytes). Every
+ *          cache - the storage engine's buffer pool and the node cache of
+ *          each B+tree index - registers for a MemoryBudget and sizes itself
+ *          by it, so adding indexes no longer adds memory: a new index's
+ *          share is taken from the other caches.
+ *
+ * Budget split:
+ * - Query working memory: a fixed fraction set aside for operators that
+ *   build in-memory state (reserve_query_memory())
+ * - The rest is shared by the caches. The buffer pool registers first and
+ *   takes whatever is unassigned; each index then takes its initial share
+ *   from the largest cache, which never drops below its floor.
+ *
+ * Rebalancing (every REBALANCE_MISSES misses, or rebalance()):
+ * - For each cache, the misses since the last rebalance per byte of its
+ *   share, weighted by the cost of a miss, say how much more memory would
+ *   help it. A buffer pool miss reads the file (cost 1); a node cache miss
+ *   usually only decodes a page the pool still holds, so it costs less.
+ * - One step (1/32 of the cache budget) moves from the cache with the
+ *   lowest miss density to the one with the highest, if the highest is at
+ *   least twice the lowest. Caches that stay hot give up memory they do
+ *   not need; a cache that keeps missing grows step by step.
+ *
+ * Shares of caches that are destroyed go back to the largest live cache.
+ *
+ * Thread safety: all methods may be called concurrently.
+ *
+ * Example:
+ * @code
+ * auto governor = std::make_shared<MemoryGovernor>(64 * 1024 * 1024);
+ * auto pool = governor->register_cache("buffer pool", 4096, 16);
+ * auto nodes = governor->register_cache("index", 4096, 4, 0.25, 32 * 4096);
+ * // caches size themselves by pool->limit_units() and nodes->limit_units()
+ * @endcode
+ */
+class MemoryGovernor : public std::enable_shared_from_this<MemoryGovernor> {
+public:
+    /**
+     * @brief Misses (across all caches) between automatic rebalances
+     */
+    static constexpr uint64_t REBALANCE_MISSES = 1024;
+
+    /**
+     * @brief A cache's share, as reported by shares()
+     */
+    struct Share {
+        std::string name;         ///< Cache name
+        std::size_t limit_bytes;  ///< Current share in bytes
+        uint64_t hits;            ///< Lookups served from the cache
+        uint64_t misses;          ///< Lookups that missed
+    };
+
+    /**
+     * @brief Creates a governor
+     * @param budget_bytes Total memory for the caches and query working memory
+     * @param query_fraction Part of the budget set aside for query working memory
+     */
+    explicit MemoryGovernor(std::size_t budget_bytes, double query_fraction = 0.10)
+        : budget_bytes_{budget_bytes},
+          query_bytes_{static_cast<std::size_t>(static_cast<double>(budget_bytes) *
+                                                std::clamp(query_fraction, 0.0, 1.0))},
+          query_in_use_{0},
+          budgets_{},
+          misses_since_rebalance_{0},
+          rebalances_{0},
+          mutex_{} {}
+
+    MemoryGovernor(const MemoryGovernor&) = delete;
+    MemoryGovernor& operator=(const MemoryGovernor&) = delete;
+
+    /**
+     * @brief Registers a cache and gives it a share of the budget
+     * @param name Name shown in shares()
+     * @param unit_bytes Size of one cached item
+     * @param floor_units Items the cache always keeps
+     * @param miss_cost Relative cost of one miss (1.0 = a page read from the file)
+     * @param wanted_bytes Initial share; the default takes everything unassigned
+     * @return The cache's share (the registration ends when it is destroyed)
+     *
+     * The share is taken from unassigned memory first, then from the largest
+     * cache down to its floor. If the budget is exhausted the cache still
+     * gets its floor.
+     */
+    [[nodiscard]] std::shared_ptr<MemoryBudget> register_cache(
+        std::string name, std::size_t unit_bytes, std::size_t floor_units, double miss_cost = 1.0,
+        std::size_t wanted_bytes = std::numeric_limits<std::size_t>::max()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        prune();
+
+        std::size_t unassigned = cache_bytes() - std::min(cache_bytes(), assigned_bytes());
+        std::size_t granted = std::min(wanted_bytes, unassigned);
+
+        std::size_t floor_bytes = std::max<std::size_t>(floor_units, 1) * std::max<std::size_t>(unit_bytes, 1);
+        std::size_t target = std::max(floor_bytes, wanted_bytes == std::numeric_limits<std::size_t>::max()
+                                                       ? granted : wanted_bytes);
+        if (granted < target) {
+            if (auto donor = largest()) {
+                std::size_t taken = std::min(target - granted, spare_bytes(*donor));
+                donor->limit_bytes_.fetch_sub(taken, std::memory_order_relaxed);
+                granted += taken;
+            }
+        }
+
+        auto budget = std::make_shared<MemoryBudget>(std::move(name), unit_bytes, floor_units, miss_cost,
+                                                     std::max(granted, floor_bytes), weak_from_this());
+        budgets_.push_back(budget);
+        return budget;
+    }
+
+    /**
+     * @brief Moves memory from the cache that needs it least to the one that
+     *        needs it most (see the class notes)
+     * @return true if a share changed
+     */
+    bool rebalance() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        misses_since_rebalance_.store(0, std::memory_order_relaxed);
+        prune();
+
+        std::shared_ptr<MemoryBudget> donor;
+        std::shared_ptr<MemoryBudget> recipient;
+        double donor_density = std::numeric_limits<double>::max();
+        double recipient_density = 0.0;
+
+        for (const auto& weak : budgets_) {
+            auto budget = weak.lock();
+            if (!budget) {
+                continue;
+            }
+            uint64_t misses = budget->misses();
+            uint64_t recent = misses - budget->seen_misses_;
+            budget->seen_misses_ = misses;
+
+            double density = static_cast<double>(recent) * budget->miss_cost() /
+                             static_cast<double>(std::max<std::size_t>(budget->limit_bytes(), 1));
+            if (density > recipient_density) {
+                recipient_density = density;
+                recipient = budget;
+            }
+            if (spare_bytes(*budget) > 0 && density < donor_density) {
+                donor_density = density;
+                donor = budget;
+            }
+        }
+
+        if (!donor || !recipient || donor == recipient || recipient_density < 2.0 * donor_density) {
+            return false;
+        }
+
+        std::size_t step = std::min(std::max<std::size_t>(cache_bytes() / 32, recipient->unit_bytes()),
+                                    spare_bytes(*donor));
+        donor->limit_bytes_.fetch_sub(step, std::memory_order_relaxed);
+        recipient->limit_bytes_.fetch_add(step, std::memory_order_relaxed);
+        ++rebalances_;
+        return true;
+    }
+
+    /**
+     * @brief Reserves query working memory
+     * @param bytes Memory the operator would like
+     * @return Bytes granted (possibly fewer, or 0); release them with
+     *         release_query_memory() when the operator finishes
+     *
+     * An operator that is granted less than it asked for should partition
+     * or spill its input rather than exceed the grant.
+     */
+    [[nodiscard]] std::size_t reserve_query_memory(std::size_t bytes) noexcept {
+        std::size_t in_use = query_in_use_.load(std::memory_order_relaxed);
+        std::size_t granted = 0;
+        do {
+            granted = std::min(bytes, query_bytes_ - std::min(query_bytes_, in_use));
+        } while (!query_in_use_.compare_exchange_weak(in_use, in_use + granted, std::memory_order_relaxed));
+        return granted;
+    }
+
+    /**
+     * @brief Returns memory granted by reserve_query_memory()
+     */
+    void release_query_memory(std::size_t bytes) noexcept {
+        query_in_use_.fetch_sub(bytes, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the query working memory set aside
+     */
+    [[nodiscard]] std::size_t query_memory_bytes() const noexcept {
+        return query_bytes_;
+    }
+
+    /**
+     * @brief Gets the query working memory currently reserved
+     */
+    [[nodiscard]] std::size_t query_memory_in_use() const noexcept {
+        return query_in_use_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the total budget
+     */
+    [[nodiscard]] std::size_t budget_bytes() const noexcept {
+        return budget_bytes_;
+    }
+
+    /**
+     * @brief Gets the number of rebalances that moved memory
+     */
+    [[nodiscard]] uint64_t rebalance_count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return rebalances_;
+    }
+
+    /**
+     * @brief Lists the live caches and their shares, in registration order
+     */
+    [[nodiscard]] std::vector<Share> shares() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Share> result;
+        for (const auto& weak : budgets_) {
+            if (auto budget = weak.lock()) {
+                result.push_back(Share{budget->name(), budget->limit_bytes(), budget->hits(), budget->misses()});
+            }
+        }
+        return result;
+    }
+
+private:
+    friend class MemoryBudget;
+
+    /**
+     * @brief Counts a miss and rebalances every REBALANCE_MISSES misses
+     */
+    void note_miss() {
+        if (misses_since_rebalance_.fetch_add(1, std::memory_order_relaxed) + 1 >= REBALANCE_MISSES) {
+            rebalance();
+        }
+    }
+
+    /**
+     * @brief Memory shared by the caches
+     */
+    [[nodiscard]] std::size_t cache_bytes() const noexcept {
+        return budget_bytes_ - query_bytes_;
+    }
+
+    /**
+     * @brief Sum of the live caches' shares (governor lock held)
+     */
+    [[nodiscard]] std::size_t assigned_bytes() const {
+        std::size_t total = 0;
+        for (const auto& weak : budgets_) {
+            if (auto budget = weak.lock()) {
+                total += budget->limit_bytes();
+            }
+        }
+        return total;
+    }
+
+    /**
+     * @brief Bytes a cache can give up without going below its floor
+     */
+    [[nodiscard]] static std::size_t spare_bytes(const MemoryBudget& budget) noexcept {
+        std::size_t floor_bytes = budget.floor_units() * budget.unit_bytes();
+        std::size_t limit = budget.limit_bytes();
+        return limit > floor_bytes ? limit - floor_bytes : 0;
+    }
+
+    /**
+     * @brief Finds the live cache with the largest share (governor lock held)
+     */
+    [[nodiscard]] std::shared_ptr<MemoryBudget> largest() const {
+        std::shared_ptr<MemoryBudget> result;
+        for (const auto& weak : budgets_) {
+            auto budget = weak.lock();
+            if (budget && (!result || budget->limit_bytes() > result->limit_bytes())) {
+                result = std::move(budget);
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Drops destroyed caches, handing their shares to the largest one
+     *        (governor lock held)
+     */
+    void prune() {
+        auto dead = std::remove_if(budgets_.begin(), budgets_.end(), [](const auto& weak) { return weak.expired(); });
+        if (dead == budgets_.end()) {
+            return;
+        }
+        budgets_.erase(dead, budgets_.end());
+
+        std::size_t assigned = assigned_bytes();
+        if (auto recipient = largest(); recipient && assigned < cache_bytes()) {
+            recipient->limit_bytes_.fetch_add(cache_bytes() - assigned, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t budget_bytes_;                          ///< Total budget
+    std::size_t query_bytes_;                           ///< Query working memory set aside
+    std::atomic<std::size_t> query_in_use_;             ///< Query working memory reserved
+    std::vector<std::weak_ptr<MemoryBudget>> budgets_;  ///< Registered caches
+    std::atomic<uint64_t> misses_since_rebalance_;      ///< Misses since the last rebalance
+    uint64_t rebalances_;                               ///< Rebalances that moved memory
+    mutable std::mutex mutex_;                          ///< Guards budgets_ and the seen miss counts
+};
+
+inline void MemoryBudget::record_miss() {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    if (auto governor = governor_.lock()) {
+        governor->note_miss();
+    }
+}
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_MEMORY_GOVERNOR_HPP
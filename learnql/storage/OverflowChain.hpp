@@ -0,0 +1,180 @@
+#ifndef LEARNQL_STORAGE_OVERFLOW_CHAIN_HPP
+#define LEARNQL_STORAGE_OVERFLOW_CHAIN_HPP
+
+#include "StorageEngine.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace learnql::storage {
+
+/**
+ * @brief Where a record stored in overflow pages lives, as kept in its head slot
+ * @details Encoded as 12 bytes: total length (4) then first page ID (8).
+ */
+struct OverflowHead {
+    static constexpr std::size_t SIZE = 12;  ///< Encoded size in bytes
+
+    uint32_t length;      ///< Record length in bytes
+    uint64_t first_page;  ///< First page of the chain
+
+    /**
+     * @brief Encodes the head for storing in a slot
+     */
+    [[nodiscard]] std::array<uint8_t, SIZE> encode() const noexcept {
+        std::array<uint8_t, SIZE> bytes{};
+        std::memcpy(bytes.data(), &length, sizeof(length));
+        std::memcpy(bytes.data() + sizeof(length), &first_page, sizeof(first_page));
+        return bytes;
+    }
+
+    /**
+     * @brief Decodes a head read from a slot
+     * @throws std::runtime_error if the slot is not a head
+     */
+    [[nodiscard]] static OverflowHead decode(std::span<const uint8_t> bytes) {
+        if (bytes.size() < SIZE) {
+            throw std::runtime_error("Invalid overflow record head");
+        }
+        OverflowHead head{};
+        std::memcpy(&head.length, bytes.data(), sizeof(head.length));
+        std::memcpy(&head.first_page, bytes.data() + sizeof(head.length), sizeof(head.first_page));
+        return head;
+    }
+};
+
+/**
+ * @brief Stores records too large for one page in a chain of OVERFLOW_DATA pages
+ * @details The record's bytes are cut into page-sized chunks, one per
+ *          page, at data offset 0; only the last chunk is shorter than a
+ *          page's data section. Each page's header links to the next page
+ *          (next_page_id, 0 at the end). The pages of a chain are allocated as one
+ *          contiguous run, so a chain is written and read back sequentially
+ *          and can be freed without reading it.
+ *
+ * The record's slot in its data page holds only an OverflowHead (see
+ * SlottedPage::SLOT_OVERFLOW).
+ *
+ * Example:
+ * @code
+ * OverflowHead head = OverflowChain::write(engine, writer.get_buffer());
+ * OverflowChain::Reader chain(engine, head);
+ * BinaryReader reader(head.length, [&chain] { return chain.next(); });
+ * auto record = reader.read_custom<Document>();
+ * OverflowChain::free(engine, head);
+ * @endcode
+ */
+class OverflowChain {
+public:
+    /**
+     * @brief Bytes of a record held by each overflow page
+     */
+    [[nodiscard]] static std::size_t chunk_size(const StorageEngine& engine) noexcept {
+        return engine.get_page_size() - sizeof(PageHeader);
+    }
+
+    /**
+     * @brief Number of pages in the chain of a record of the given length
+     */
+    [[nodiscard]] static std::size_t page_count(const StorageEngine& engine, std::size_t length) noexcept {
+        return std::max<std::size_t>(1, (length + chunk_size(engine) - 1) / chunk_size(engine));
+    }
+
+    /**
+     * @brief Writes a record to a new chain
+     * @param engine Storage engine
+     * @param record Record bytes
+     * @return Head to keep in the record's slot
+     * @throws std::runtime_error if the record is 4 GB or larger
+     */
+    [[nodiscard]] static OverflowHead write(StorageEngine& engine, std::span<const uint8_t> record) {
+        if (record.size() > UINT32_MAX) {
+            throw std::runtime_error("Record too large: " + std::to_string(record.size()) + " bytes");
+        }
+
+        std::size_t count = page_count(engine, record.size());
+        std::size_t chunk = chunk_size(engine);
+        uint64_t first = engine.allocate_pages(count, PageType::OVERFLOW_DATA);
+        for (std::size_t i = 0; i < count; ++i) {
+            auto piece = record.subspan(i * chunk, std::min(chunk, record.size() - i * chunk));
+            PageGuard page = engine.reset_page(first + i, PageType::OVERFLOW_DATA);
+            page->write_data(0, piece.data(), piece.size());
+            page->header().record_count = 1;
+            page->header().next_page_id = i + 1 < count ? first + i + 1 : 0;
+        }
+        return OverflowHead{static_cast<uint32_t>(record.size()), first};
+    }
+
+    /**
+     * @brief Deallocates a record's chain
+     * @param engine Storage engine
+     * @param head Head of the record
+     */
+    static void free(StorageEngine& engine, const OverflowHead& head) {
+        std::size_t count = page_count(engine, head.length);
+        for (std::size_t i = 0; i < count; ++i) {
+            engine.deallocate_page(head.first_page + i);
+        }
+    }
+
+    /**
+     * @brief Walks a chain one page at a time, for a chunked BinaryReader
+     * @details Keeps the current page pinned until the next chunk is asked
+     *          for. The whole chain is prefetched as one batch first.
+     */
+    class Reader {
+    public:
+        /**
+         * @brief Prepares to read a record's chain
+         * @param engine Storage engine
+         * @param head Head of the record
+         */
+        Reader(StorageEngine& engine, const OverflowHead& head)
+            : engine_{engine}, page_{}, next_page_{head.first_page}, remaining_{head.length} {
+            std::size_t count = page_count(engine_, head.length);
+            if (count > 1) {
+                std::vector<uint64_t> pages(count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    pages[i] = head.first_page + i;
+                }
+                engine_.prefetch_pages(pages);
+            }
+        }
+
+        /**
+         * @brief Returns the next chunk of the record (empty after the last one)
+         * @throws std::runtime_error if a page of the chain is not an overflow page
+         */
+        [[nodiscard]] std::span<const uint8_t> next() {
+            if (remaining_ == 0 || next_page_ == 0) {
+                page_ = PageRef{};
+                return {};
+            }
+            page_ = engine_.fetch_page(next_page_);
+            const PageHeader& header = page_->header();
+            if (header.page_type != PageType::OVERFLOW_DATA) {
+                throw std::runtime_error("Page " + std::to_string(next_page_) + " is not an overflow page");
+            }
+            next_page_ = header.next_page_id;
+            auto chunk = page_->data().first(std::min(remaining_, page_->data_size()));
+            remaining_ -= chunk.size();
+            return chunk;
+        }
+
+    private:
+        StorageEngine& engine_;  ///< Storage engine
+        PageRef page_;           ///< Page holding the current chunk
+        uint64_t next_page_;     ///< Next page of the chain (0 = none)
+        std::size_t remaining_;  ///< Record bytes not yet returned
+    };
+};
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_OVERFLOW_CHAIN_HPP
@@ -1,12 +1,17 @@
 #ifndef LEARNQL_STORAGE_PAGE_HPP
 #define LEARNQL_STORAGE_PAGE_HPP
 
+#include "Crc32c.hpp"
 #include <cstdint>
+#include <cstddef>
 #include <cstring>
 #include <array>
+#include <memory>
+#include <new>
 #include <span>
 #include <stdexcept>
 #include <compare>
+#include <utility>
 
 namespace learnql::storage {
 
@@ -17,11 +22,44 @@ namespace learnql::storage {
 constexpr std::array<char, 4> MAGIC_NUMBER = {'L', 'Q', 'L', '1'};
 
 /**
- * @brief Standard page size (4KB)
- * @details Common page size for efficient disk I/O
+ * @brief Default page size (4KB)
+ * @details Common page size for efficient disk I/O. A database can be
+ *          created with larger pages (see StorageOptions::page_size).
  */
 constexpr std::size_t PAGE_SIZE = 4096;
 
+/**
+ * @brief Smallest supported page size
+ */
+constexpr std::size_t MIN_PAGE_SIZE = 4096;
+
+/**
+ * @brief Largest supported page size (64KB)
+ */
+constexpr std::size_t MAX_PAGE_SIZE = 65536;
+
+/**
+ * @brief Alignment of every page buffer
+ * @details Direct I/O (O_DIRECT) requires buffers aligned to the device's
+ *          logical block size; 4KB covers common disks and SSDs. Page sizes
+ *          are multiples of it, so page offsets in the file are aligned too.
+ */
+constexpr std::size_t PAGE_ALIGNMENT = 4096;
+
+/**
+ * @brief Checks whether a page size is supported (a power of two, 4KB-64KB)
+ */
+[[nodiscard]] constexpr bool is_valid_page_size(std::size_t size) noexcept {
+    return size >= MIN_PAGE_SIZE && size <= MAX_PAGE_SIZE && (size & (size - 1)) == 0;
+}
+
+/**
+ * @brief Page format version written by this library
+ * @details Version 1 pages carry a byte-wise XOR of the data section;
+ *          version 2 pages carry a CRC32C of the header and data.
+ */
+constexpr uint8_t PAGE_FORMAT_VERSION = 2;
+
 /**
  * @brief Types of pages in the storage system
  */
@@ -30,9 +68,17 @@ enum class PageType : uint8_t {
     DATA = 1,        ///< Contains record data
     INDEX = 2,       ///< Contains index data (future use)
     METADATA = 3,    ///< Contains database metadata
-    OVERFLOW_DATA = 4 ///< Contains overflow data for large records (renamed to avoid macro conflict)
+    OVERFLOW_DATA = 4, ///< Contains overflow data for large records (renamed to avoid macro conflict)
+    FREE_SPACE_MAP = 5 ///< Allocation bitmap of one group of pages (see FreeSpaceMap)
 };
 
+/**
+ * @brief PageHeader::flags bit: the data section is a slotted page (see SlottedPage)
+ * @details DATA pages written before slotted pages hold a single record at
+ *          offset 0 and have this bit clear.
+ */
+constexpr uint8_t PAGE_FLAG_SLOTTED = 0x01;
+
 /**
  * @brief Page header structure (64 bytes)
  * @details Contains metadata about the page
@@ -45,8 +91,10 @@ enum class PageType : uint8_t {
  * - Record count: 2 bytes (number of records in page)
  * - Free space offset: 2 bytes (where free space begins)
  * - Next page: 8 bytes (for linked lists)
- * - Checksum: 4 bytes (for integrity checking)
- * - Reserved: 34 bytes (for future use)
+ * - Checksum: 4 bytes (CRC32C of the page with this field taken as zero)
+ * - LSN: 8 bytes (log sequence number of the last WAL record for this page)
+ * - Flags: 1 byte (PAGE_FLAG_* bits)
+ * - Reserved: 25 bytes (for future use)
  */
 #pragma pack(push, 1)
 struct PageHeader {
@@ -57,8 +105,10 @@ struct PageHeader {
     uint16_t record_count;           ///< Number of records in this page
     uint16_t free_space_offset;      ///< Offset to free space
     uint64_t next_page_id;           ///< Next page in chain (0 = none)
-    uint32_t checksum;               ///< CRC32 checksum
-    std::array<uint8_t, 34> reserved; ///< Reserved for future use
+    uint32_t checksum;               ///< CRC32C checksum (XOR in version 1 pages)
+    uint64_t lsn;                    ///< WAL position of the page's latest image (0 = never logged)
+    uint8_t flags;                   ///< PAGE_FLAG_* bits
+    std::array<uint8_t, 25> reserved; ///< Reserved for future use
 
     /**
      * @brief Default constructor - initializes a free page
@@ -67,11 +117,13 @@ struct PageHeader {
         : magic(MAGIC_NUMBER),
           page_id(0),
           page_type(PageType::FREE),
-          version(1),
+          version(PAGE_FORMAT_VERSION),
           record_count(0),
           free_space_offset(sizeof(PageHeader)),
           next_page_id(0),
           checksum(0),
+          lsn(0),
+          flags(0),
           reserved{} {}
 
     /**
@@ -93,56 +145,103 @@ struct PageHeader {
 static_assert(sizeof(PageHeader) == 64, "PageHeader must be exactly 64 bytes");
 
 /**
- * @brief A single page in the storage system (4KB)
- * @details Fixed-size page containing header and data
+ * @brief A single page in the storage system
+ * @details Header followed by a data section; the page size is chosen per
+ *          database (4KB by default)
  *
  * Layout:
  * - Header: 64 bytes (PageHeader)
- * - Data: 4032 bytes (PAGE_SIZE - sizeof(PageHeader))
+ * - Data: size() - 64 bytes (4032 for a 4KB page)
  *
  * Features:
- * - RAII-based memory management
+ * - RAII-based memory management (one contiguous buffer, header first,
+ *   aligned to PAGE_ALIGNMENT for direct I/O)
  * - Safe data access via std::span
- * - Compile-time size validation
- * - C++20 three-way comparison
+ * - Read-only views over pages that live elsewhere (e.g. a memory mapping)
  */
 class Page {
 public:
     /**
-     * @brief Size of data section
+     * @brief Default constructor - creates a free page of the default size
      */
-    static constexpr std::size_t DATA_SIZE = PAGE_SIZE - sizeof(PageHeader);
-
-    /**
-     * @brief Default constructor - creates a free page
-     */
-    Page() noexcept : header_{}, data_{} {}
+    Page() : Page(0, PageType::FREE) {}
 
     /**
      * @brief Constructs a page with specific type and ID
      * @param page_id Unique page identifier
      * @param type Type of page
+     * @param size Page size in bytes (header included)
      */
-    explicit Page(uint64_t page_id, PageType type = PageType::DATA) noexcept
-        : header_{}, data_{} {
-        header_.page_id = page_id;
-        header_.page_type = type;
+    explicit Page(uint64_t page_id, PageType type = PageType::DATA, std::size_t size = PAGE_SIZE)
+        : owned_{allocate(size)}, bytes_{owned_.get()}, size_{size} {
+        reset(page_id, type);
+    }
+
+    /**
+     * @brief Creates a read-only view of a page stored elsewhere
+     * @param bytes Start of the page (must outlive the view)
+     * @param size Page size in bytes
+     * @details Copying a view makes an ordinary, owning page.
+     */
+    [[nodiscard]] static Page view(const uint8_t* bytes, std::size_t size) noexcept {
+        return Page(const_cast<uint8_t*>(bytes), size);
+    }
+
+    // Copies are deep (needed for caching)
+    Page(const Page& other)
+        : owned_{allocate(other.size_)},
+          bytes_{owned_.get()},
+          size_{other.size_} {
+        std::memcpy(bytes_, other.bytes_, size_);
     }
 
-    // Default copy operations (needed for caching)
-    Page(const Page&) = default;
-    Page& operator=(const Page&) = default;
+    Page& operator=(const Page& other) {
+        if (this != &other) {
+            if (!owned_ || size_ != other.size_) {
+                owned_ = allocate(other.size_);
+                bytes_ = owned_.get();
+                size_ = other.size_;
+            }
+            std::memcpy(bytes_, other.bytes_, size_);
+        }
+        return *this;
+    }
+
+    // Moves take over the buffer
+    Page(Page&& other) noexcept
+        : owned_{std::move(other.owned_)},
+          bytes_{std::exchange(other.bytes_, nullptr)},
+          size_{std::exchange(other.size_, 0)} {}
+
+    Page& operator=(Page&& other) noexcept {
+        if (this != &other) {
+            owned_ = std::move(other.owned_);
+            bytes_ = std::exchange(other.bytes_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Gets the page size in bytes (header included)
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
 
-    // Default move operations
-    Page(Page&&) noexcept = default;
-    Page& operator=(Page&&) noexcept = default;
+    /**
+     * @brief Gets the size of the data section in bytes
+     */
+    [[nodiscard]] std::size_t data_size() const noexcept {
+        return size_ - sizeof(PageHeader);
+    }
 
     /**
      * @brief Gets the page header
      * @return Reference to the header
      */
     [[nodiscard]] PageHeader& header() noexcept {
-        return header_;
+        return *std::launder(reinterpret_cast<PageHeader*>(bytes_));
     }
 
     /**
@@ -150,7 +249,7 @@ public:
      * @return Const reference to the header
      */
     [[nodiscard]] const PageHeader& header() const noexcept {
-        return header_;
+        return *std::launder(reinterpret_cast<const PageHeader*>(bytes_));
     }
 
     /**
@@ -158,7 +257,7 @@ public:
      * @return std::span providing safe access to data
      */
     [[nodiscard]] std::span<uint8_t> data() noexcept {
-        return std::span<uint8_t>(data_.data(), data_.size());
+        return std::span<uint8_t>(bytes_ + sizeof(PageHeader), data_size());
     }
 
     /**
@@ -166,7 +265,7 @@ public:
      * @return std::span providing safe read-only access to data
      */
     [[nodiscard]] std::span<const uint8_t> data() const noexcept {
-        return std::span<const uint8_t>(data_.data(), data_.size());
+        return std::span<const uint8_t>(bytes_ + sizeof(PageHeader), data_size());
     }
 
     /**
@@ -177,10 +276,10 @@ public:
      * @throws std::out_of_range if offset + size exceeds page size
      */
     void write_data(std::size_t offset, const void* src, std::size_t size) {
-        if (offset + size > DATA_SIZE) {
+        if (offset + size > data_size()) {
             throw std::out_of_range("Write exceeds page boundary");
         }
-        std::memcpy(data_.data() + offset, src, size);
+        std::memcpy(bytes_ + sizeof(PageHeader) + offset, src, size);
     }
 
     /**
@@ -191,18 +290,29 @@ public:
      * @throws std::out_of_range if offset + size exceeds page size
      */
     void read_data(std::size_t offset, void* dest, std::size_t size) const {
-        if (offset + size > DATA_SIZE) {
+        if (offset + size > data_size()) {
             throw std::out_of_range("Read exceeds page boundary");
         }
-        std::memcpy(dest, data_.data() + offset, size);
+        std::memcpy(dest, bytes_ + sizeof(PageHeader) + offset, size);
+    }
+
+    /**
+     * @brief Reinitializes the page in place as an empty page
+     * @param page_id Unique page identifier
+     * @param type Type of page
+     */
+    void reset(uint64_t page_id, PageType type) noexcept {
+        clear();
+        header().page_id = page_id;
+        header().page_type = type;
     }
 
     /**
      * @brief Clears the page (resets to free state)
      */
     void clear() noexcept {
-        header_ = PageHeader{};
-        data_.fill(0);
+        std::memset(bytes_, 0, size_);
+        new (bytes_) PageHeader{};
     }
 
     /**
@@ -210,7 +320,7 @@ public:
      * @return Number of bytes available
      */
     [[nodiscard]] std::size_t available_space() const noexcept {
-        return DATA_SIZE - header_.free_space_offset + sizeof(PageHeader);
+        return data_size() - header().free_space_offset + sizeof(PageHeader);
     }
 
     /**
@@ -227,7 +337,7 @@ public:
      * @return Pointer to beginning of page (header)
      */
     [[nodiscard]] const void* raw_data() const noexcept {
-        return &header_;
+        return bytes_;
     }
 
     /**
@@ -235,45 +345,83 @@ public:
      * @return Pointer to beginning of page (header)
      */
     [[nodiscard]] void* raw_data() noexcept {
-        return &header_;
+        return bytes_;
     }
 
     /**
-     * @brief Computes CRC32 checksum of page data
+     * @brief Computes the CRC32C checksum of the page
      * @return Checksum value
+     * @details Covers the header (with the checksum field read as zero) and
+     *          the data section, so a corrupted page ID or type is caught too.
      */
     [[nodiscard]] uint32_t compute_checksum() const noexcept {
-        uint32_t checksum = 0;
-        // Simple XOR-based checksum for educational purposes
-        // In production, use proper CRC32
-        for (const auto& byte : data_) {
-            checksum ^= byte;
-        }
-        return checksum;
+        constexpr std::size_t field = offsetof(PageHeader, checksum);
+        constexpr uint32_t zero = 0;
+
+        uint32_t crc = crc32c(bytes_, field);
+        crc = crc32c(&zero, sizeof(zero), crc);
+        return crc32c(bytes_ + field + sizeof(zero), size_ - field - sizeof(zero), crc);
     }
 
     /**
-     * @brief Updates the checksum in the header
+     * @brief Updates the checksum in the header (and marks the page as version 2)
      */
     void update_checksum() noexcept {
-        header_.checksum = compute_checksum();
+        header().version = PAGE_FORMAT_VERSION;
+        header().checksum = compute_checksum();
     }
 
     /**
      * @brief Validates the checksum
      * @return true if checksum is valid
+     * @details Pages written before version 2 are checked against the old XOR sum.
      */
     [[nodiscard]] bool validate_checksum() const noexcept {
-        return header_.checksum == compute_checksum();
+        if (header().version < 2) {
+            return header().checksum == legacy_checksum();
+        }
+        return header().checksum == compute_checksum();
     }
 
 private:
-    PageHeader header_;                ///< Page metadata
-    std::array<uint8_t, DATA_SIZE> data_; ///< Page data section
-};
+    /**
+     * @brief Byte-wise XOR of the data section (version 1 pages)
+     */
+    [[nodiscard]] uint32_t legacy_checksum() const noexcept {
+        uint32_t checksum = 0;
+        for (const auto& byte : data()) {
+            checksum ^= byte;
+        }
+        return checksum;
+    }
+
+    /**
+     * @brief Frees a buffer obtained from allocate()
+     */
+    struct AlignedDelete {
+        void operator()(uint8_t* bytes) const noexcept {
+            ::operator delete[](bytes, std::align_val_t{PAGE_ALIGNMENT});
+        }
+    };
 
-// Ensure Page is exactly PAGE_SIZE bytes
-static_assert(sizeof(Page) == PAGE_SIZE, "Page must be exactly PAGE_SIZE bytes");
+    using Buffer = std::unique_ptr<uint8_t[], AlignedDelete>;
+
+    /**
+     * @brief Allocates an uninitialized page buffer aligned to PAGE_ALIGNMENT
+     */
+    [[nodiscard]] static Buffer allocate(std::size_t size) {
+        return Buffer(static_cast<uint8_t*>(::operator new[](size, std::align_val_t{PAGE_ALIGNMENT})));
+    }
+
+    /**
+     * @brief Non-owning constructor used by view()
+     */
+    Page(uint8_t* bytes, std::size_t size) noexcept : owned_{}, bytes_{bytes}, size_{size} {}
+
+    Buffer owned_;          ///< Page buffer, PAGE_ALIGNMENT-aligned (empty for views)
+    uint8_t* bytes_;        ///< Start of the page: header, then data
+    std::size_t size_;      ///< Page size in bytes
+};
 
 } // namespace learnql::storage
 
@@ -0,0 +1,182 @@
+#ifndef LEARNQL_STORAGE_PAGE_GUARD_HPP
+#define LEARNQL_STORAGE_PAGE_GUARD_HPP
+
+#include "Page.hpp"
+#include "BufferPool.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+namespace learnql::storage {
+
+/**
+ * @brief RAII handle to a pinned buffer pool frame
+ * @tparam Mutable true for write access (frame is marked dirty on release)
+ *
+ * A guard refers directly to the page inside its frame - nothing is copied.
+ * While the guard is alive the frame is pinned and cannot be evicted; the
+ * destructor (or release()) unpins it. Guards are move-only.
+ *
+ * A guard also holds the frame's latch: shared for a PageRef, exclusive for
+ * a PageGuard. Any number of threads can read a page at once, and a writer
+ * has it to itself. A thread must not ask for a PageGuard on a page it
+ * already holds through another guard (it would wait for itself).
+ *
+ * Use the aliases:
+ * - PageRef:   read-only view, leaves the frame's dirty state untouched
+ * - PageGuard: mutable view, marks the frame dirty when released
+ *
+ * Example:
+ * @code
+ * {
+ *     PageRef ref = storage.fetch_page(page_id);
+ *     BinaryReader reader(ref->data());       // Reads straight from the frame
+ * }                                           // Unpinned here
+ *
+ * {
+ *     PageGuard guard = storage.fetch_page_mut(page_id);
+ *     guard->write_data(0, bytes.data(), bytes.size());
+ * }                                           // Unpinned and marked dirty
+ * @endcode
+ */
+template<bool Mutable>
+class BasicPageGuard {
+public:
+    using page_type = std::conditional_t<Mutable, Page, const Page>;
+
+    /**
+     * @brief Creates an empty guard (holds no page)
+     */
+    BasicPageGuard() noexcept
+        : pool_{nullptr}, frame_{nullptr}, page_{nullptr} {}
+
+    /**
+     * @brief Adopts a pin on a frame and latches it
+     * @param pool Pool owning the frame
+     * @param frame Frame that has already been pinned for this guard
+     * @param latched true if the caller already holds the frame's latch in
+     *        this guard's mode (shared for PageRef, exclusive for PageGuard)
+     *
+     * Waits for the latch otherwise, so the caller must not hold the
+     * storage engine's lock here.
+     */
+    BasicPageGuard(BufferPool* pool, BufferPool::Frame* frame, bool latched = false) noexcept
+        : pool_{pool}, frame_{frame}, page_{&frame->page} {
+        if (!latched) {
+            if constexpr (Mutable) {
+                frame_->latch.lock();
+            } else {
+                frame_->latch.lock_shared();
+            }
+        }
+    }
+
+    /**
+     * @brief Wraps a page that needs no pin (e.g. a view into a mapped file)
+     * @param page Page that stays valid for the guard's lifetime
+     */
+    explicit BasicPageGuard(page_type* page) noexcept
+        : pool_{nullptr}, frame_{nullptr}, page_{page} {}
+
+    /**
+     * @brief Destructor - unlatches and unpins the frame
+     */
+    ~BasicPageGuard() {
+        release();
+    }
+
+    // Disable copy (a pin is owned by exactly one guard)
+    BasicPageGuard(const BasicPageGuard&) = delete;
+    BasicPageGuard& operator=(const BasicPageGuard&) = delete;
+
+    // Allow move
+    BasicPageGuard(BasicPageGuard&& other) noexcept
+        : pool_{std::exchange(other.pool_, nullptr)},
+          frame_{std::exchange(other.frame_, nullptr)},
+          page_{std::exchange(other.page_, nullptr)} {}
+
+    BasicPageGuard& operator=(BasicPageGuard&& other) noexcept {
+        if (this != &other) {
+            release();
+            pool_ = std::exchange(other.pool_, nullptr);
+            frame_ = std::exchange(other.frame_, nullptr);
+            page_ = std::exchange(other.page_, nullptr);
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Unlatches and unpins the frame early (the guard becomes empty)
+     * @details A PageGuard marks the frame dirty before letting go of it,
+     *          so a write-back waiting for the latch sees the change.
+     */
+    void release() noexcept {
+        if (pool_) {
+            if constexpr (Mutable) {
+                pool_->mark_dirty(*frame_);
+                frame_->latch.unlock();
+            } else {
+                frame_->latch.unlock_shared();
+            }
+            pool_->unpin(*frame_, false);
+            pool_ = nullptr;
+            frame_ = nullptr;
+        }
+        page_ = nullptr;
+    }
+
+    /**
+     * @brief Checks whether the guard holds a page
+     */
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return page_ != nullptr;
+    }
+
+    /**
+     * @brief Gets the ID of the guarded page
+     */
+    [[nodiscard]] uint64_t page_id() const noexcept {
+        return page_->header().page_id;
+    }
+
+    /**
+     * @brief Accesses the guarded page
+     */
+    [[nodiscard]] page_type& operator*() const noexcept {
+        return *page_;
+    }
+
+    /**
+     * @brief Accesses the guarded page
+     */
+    [[nodiscard]] page_type* operator->() const noexcept {
+        return page_;
+    }
+
+    /**
+     * @brief Gets the guarded page
+     */
+    [[nodiscard]] page_type& get() const noexcept {
+        return *page_;
+    }
+
+private:
+    BufferPool* pool_;          ///< Pool owning the frame (nullptr when empty)
+    BufferPool::Frame* frame_;  ///< Pinned (and latched) frame
+    page_type* page_;           ///< Page inside the frame
+};
+
+/**
+ * @brief Read-only pinned page handle
+ */
+using PageRef = BasicPageGuard<false>;
+
+/**
+ * @brief Mutable pinned page handle (marks the frame dirty on release)
+ */
+using PageGuard = BasicPageGuard<true>;
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_PAGE_GUARD_HPP
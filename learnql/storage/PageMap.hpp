@@ -0,0 +1,464 @@
+#ifndef LEARNQL_STORAGE_PAGE_MAP_HPP
+#define LEARNQL_STORAGE_PAGE_MAP_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <map>
+#include <span>
+#include <unordered_set>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace learnql::storage {
+
+/**
+ * @brief Page compression codec of a database
+ * @details Chosen when the database is created and recorded in page 0.
+ */
+enum class PageCompression : uint8_t {
+    NONE = 0,  ///< Pages stored uncompressed at page_id * page_size
+    LZ = 1     ///< Pages compressed with the built-in LZ codec (LzCodec.hpp)
+};
+
+/**
+ * @brief Location of one stored block (a page, or a piece of the page map) in the file
+ * @details Blocks start on a PageMap::SECTOR_SIZE boundary. A block whose
+ *          length equals its uncompressed size is stored uncompressed.
+ */
+struct PageSlot {
+    uint64_t sector = 0;    ///< First sector of the block
+    uint32_t length = 0;    ///< Stored bytes (0 = no slot)
+
+    [[nodiscard]] bool empty() const noexcept {
+        return length == 0;
+    }
+
+    /**
+     * @brief Byte offset of the block in the file
+     */
+    [[nodiscard]] uint64_t offset() const noexcept;
+
+    /**
+     * @brief Number of sectors the block occupies
+     */
+    [[nodiscard]] uint64_t sectors() const noexcept;
+
+    /**
+     * @brief Packs the slot into 8 bytes (40-bit sector, 24-bit length)
+     */
+    [[nodiscard]] uint64_t pack() const noexcept {
+        return (sector << 24) | length;
+    }
+
+    [[nodiscard]] static PageSlot unpack(uint64_t packed) noexcept {
+        return PageSlot{packed >> 24, static_cast<uint32_t>(packed & 0xFFFFFF)};
+    }
+};
+
+/**
+ * @brief Maps page IDs to variable-size slots in a compressed database file
+ * @details In a compressed database only page 0 keeps its fixed place at
+ *          offset 0. Every other page is stored in a slot of whole
+ *          SECTOR_SIZE sectors somewhere after it, as long as its
+ *          compressed image. The map tracks:
+ *
+ * - the slot of each page (an empty slot: never written, or freed)
+ * - free extents of sectors, reused first-fit before the file grows
+ *
+ * Pages are never rewritten in place: each write gets a new slot and the
+ * old one is released. A slot still referenced by the map on disk is only
+ * reused after commit() (the next map is durable), so a crash at any point
+ * leaves the last saved map pointing at intact pages.
+ *
+ * The map is saved in chunks of ENTRIES_PER_CHUNK entries, each stored in a
+ * slot of its own; only chunks that changed are rewritten. A directory of
+ * chunk slots (with CRC32C checksums) is stored in one more slot, which
+ * page 0 points to. At open the free extents are rebuilt from the gaps
+ * between referenced slots.
+ *
+ * Example:
+ * @code
+ * PageMap map(4096);
+ * PageSlot slot = map.allocate(1200);   // 3 sectors
+ * map.assign(7, slot);                  // Page 7 now lives there
+ * @endcode
+ */
+class PageMap {
+public:
+    static constexpr std::size_t SECTOR_SIZE = 512;        ///< Slot granularity in bytes
+    static constexpr std::size_t ENTRIES_PER_CHUNK = 512;  ///< Page entries per saved chunk
+    static constexpr std::size_t CHUNK_BYTES = ENTRIES_PER_CHUNK * sizeof(uint64_t);  ///< Uncompressed chunk size
+
+    /**
+     * @brief Creates an empty map
+     * @param page_size Page size of the database (slots start after page 0)
+     */
+    explicit PageMap(std::size_t page_size = 4096)
+        : first_sector_{page_size / SECTOR_SIZE},
+          end_sector_{first_sector_},
+          entries_{},
+          chunk_slots_{},
+          chunk_crcs_{},
+          dirty_chunks_{},
+          directory_{},
+          directory_crc_{0},
+          free_extents_{},
+          fresh_{},
+          pending_{},
+          stored_bytes_{0} {}
+
+    /**
+     * @brief Gets the slot of a page (empty if it has none)
+     */
+    [[nodiscard]] PageSlot find(uint64_t page_id) const noexcept {
+        return page_id < entries_.size() ? PageSlot::unpack(entries_[page_id]) : PageSlot{};
+    }
+
+    /**
+     * @brief Points a page at a new slot (or none), releasing its old slot
+     */
+    void assign(uint64_t page_id, PageSlot slot) {
+        if (entries_.size() <= page_id) {
+            if (slot.empty()) {
+                return;
+            }
+            entries_.resize(page_id + 1, 0);
+        }
+
+        PageSlot old = PageSlot::unpack(entries_[page_id]);
+        release(old);
+        stored_bytes_ = stored_bytes_ - old.length + slot.length;
+        entries_[page_id] = slot.pack();
+        mark_dirty(page_id / ENTRIES_PER_CHUNK);
+    }
+
+    /**
+     * @brief Reserves sectors for a block
+     * @param length Bytes to store (at least 1)
+     * @return The new slot (first fit among free extents, else at the end)
+     */
+    [[nodiscard]] PageSlot allocate(std::size_t length) {
+        if (length == 0 || length > 0xFFFFFF) {
+            throw std::invalid_argument("Invalid slot length " + std::to_string(length));
+        }
+        uint64_t sectors = (length + SECTOR_SIZE - 1) / SECTOR_SIZE;
+
+        uint64_t sector = end_sector_;
+        for (auto it = free_extents_.begin(); it != free_extents_.end(); ++it) {
+            if (it->second >= sectors) {
+                sector = it->first;
+                uint64_t remaining = it->second - sectors;
+                free_extents_.erase(it);
+                if (remaining > 0) {
+                    free_extents_.emplace(sector + sectors, remaining);
+                }
+                break;
+            }
+        }
+        if (sector == end_sector_) {
+            end_sector_ += sectors;
+        }
+
+        fresh_.insert(sector);
+        return PageSlot{sector, static_cast<uint32_t>(length)};
+    }
+
+    /**
+     * @brief Gives a slot back
+     * @details A slot allocated since the last commit() is free at once;
+     *          an older one may be referenced by the map on disk and is held
+     *          until the next commit().
+     */
+    void release(PageSlot slot) {
+        if (slot.empty()) {
+            return;
+        }
+        if (fresh_.erase(slot.sector) > 0) {
+            free_sectors(slot.sector, slot.sectors());
+        } else {
+            pending_.push_back(slot);
+        }
+    }
+
+    /**
+     * @brief Called once the map written by the last save is durable
+     * @details Slots released since the previous commit become reusable.
+     */
+    void commit() {
+        for (const PageSlot& slot : pending_) {
+            free_sectors(slot.sector, slot.sectors());
+        }
+        pending_.clear();
+        fresh_.clear();
+    }
+
+    /**
+     * @brief Checks whether any entry changed since the chunks were last saved
+     */
+    [[nodiscard]] bool is_dirty() const noexcept {
+        return std::find(dirty_chunks_.begin(), dirty_chunks_.end(), true) != dirty_chunks_.end();
+    }
+
+    /**
+     * @brief Number of chunks the map spans (saved or not)
+     */
+    [[nodiscard]] uint64_t chunk_count() const noexcept {
+        uint64_t spanned = (entries_.size() + ENTRIES_PER_CHUNK - 1) / ENTRIES_PER_CHUNK;
+        return std::max<uint64_t>(spanned, chunk_slots_.size());
+    }
+
+    /**
+     * @brief Checks whether a chunk changed since it was last saved
+     */
+    [[nodiscard]] bool is_dirty(uint64_t chunk) const noexcept {
+        return chunk < dirty_chunks_.size() && dirty_chunks_[chunk];
+    }
+
+    /**
+     * @brief Gets where a chunk is stored (empty for a chunk without entries)
+     */
+    [[nodiscard]] PageSlot chunk_slot(uint64_t chunk) const noexcept {
+        return chunk < chunk_slots_.size() ? chunk_slots_[chunk] : PageSlot{};
+    }
+
+    /**
+     * @brief Gets the checksum of a chunk's stored bytes
+     */
+    [[nodiscard]] uint32_t chunk_crc(uint64_t chunk) const noexcept {
+        return chunk < chunk_crcs_.size() ? chunk_crcs_[chunk] : 0;
+    }
+
+    /**
+     * @brief Copies a chunk's entries out (CHUNK_BYTES bytes, little-endian)
+     * @return false if every entry in the chunk is empty
+     */
+    bool store_chunk(uint64_t chunk, std::span<uint8_t> bytes) const {
+        std::memset(bytes.data(), 0, CHUNK_BYTES);
+        std::size_t first = chunk * ENTRIES_PER_CHUNK;
+        if (first >= entries_.size()) {
+            return false;
+        }
+        std::size_t count = std::min(ENTRIES_PER_CHUNK, entries_.size() - first);
+        std::memcpy(bytes.data(), entries_.data() + first, count * sizeof(uint64_t));
+        return std::any_of(entries_.begin() + first, entries_.begin() + first + count,
+                           [](uint64_t entry) { return entry != 0; });
+    }
+
+    /**
+     * @brief Records where a chunk was saved, releasing its previous slot
+     */
+    void set_chunk(uint64_t chunk, PageSlot slot, uint32_t crc) {
+        if (chunk_slots_.size() <= chunk) {
+            chunk_slots_.resize(chunk + 1);
+            chunk_crcs_.resize(chunk + 1, 0);
+        }
+        release(chunk_slots_[chunk]);
+        chunk_slots_[chunk] = slot;
+        chunk_crcs_[chunk] = crc;
+        if (chunk < dirty_chunks_.size()) {
+            dirty_chunks_[chunk] = false;
+        }
+    }
+
+    /**
+     * @brief Loads a chunk's entries from its saved bytes
+     */
+    void load_chunk(uint64_t chunk, std::span<const uint8_t> bytes) {
+        std::size_t first = chunk * ENTRIES_PER_CHUNK;
+        if (entries_.size() < first + ENTRIES_PER_CHUNK) {
+            entries_.resize(first + ENTRIES_PER_CHUNK, 0);
+        }
+        std::memcpy(entries_.data() + first, bytes.data(), std::min(bytes.size(), CHUNK_BYTES));
+    }
+
+    /**
+     * @brief Serializes the chunk directory: chunk count, then per chunk its packed slot and CRC
+     */
+    [[nodiscard]] std::vector<uint8_t> directory_bytes() const {
+        uint64_t count = chunk_slots_.size();
+        std::vector<uint8_t> bytes(sizeof(count) + count * DIRECTORY_ENTRY_SIZE);
+        std::memcpy(bytes.data(), &count, sizeof(count));
+        for (uint64_t chunk = 0; chunk < count; ++chunk) {
+            uint8_t* entry = bytes.data() + sizeof(count) + chunk * DIRECTORY_ENTRY_SIZE;
+            uint64_t packed = chunk_slots_[chunk].pack();
+            std::memcpy(entry, &packed, sizeof(packed));
+            std::memcpy(entry + sizeof(packed), &chunk_crcs_[chunk], sizeof(uint32_t));
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Loads the chunk directory saved by directory_bytes()
+     * @param bytes The directory
+     * @param slot Where the directory itself is stored
+     * @param crc Checksum of the directory bytes
+     * @throws std::runtime_error if the directory is malformed
+     */
+    void load_directory(std::span<const uint8_t> bytes, PageSlot slot, uint32_t crc) {
+        uint64_t count = 0;
+        if (bytes.size() < sizeof(count)) {
+            throw std::runtime_error("Invalid page map directory");
+        }
+        std::memcpy(&count, bytes.data(), sizeof(count));
+        if (bytes.size() != sizeof(count) + count * DIRECTORY_ENTRY_SIZE) {
+            throw std::runtime_error("Invalid page map directory");
+        }
+
+        chunk_slots_.assign(count, PageSlot{});
+        chunk_crcs_.assign(count, 0);
+        for (uint64_t chunk = 0; chunk < count; ++chunk) {
+            const uint8_t* entry = bytes.data() + sizeof(count) + chunk * DIRECTORY_ENTRY_SIZE;
+            uint64_t packed = 0;
+            std::memcpy(&packed, entry, sizeof(packed));
+            std::memcpy(&chunk_crcs_[chunk], entry + sizeof(packed), sizeof(uint32_t));
+            chunk_slots_[chunk] = PageSlot::unpack(packed);
+        }
+        directory_ = slot;
+        directory_crc_ = crc;
+    }
+
+    /**
+     * @brief Gets where the chunk directory is stored (empty before the first save)
+     */
+    [[nodiscard]] PageSlot directory() const noexcept {
+        return directory_;
+    }
+
+    /**
+     * @brief Gets the checksum of the saved directory
+     */
+    [[nodiscard]] uint32_t directory_crc() const noexcept {
+        return directory_crc_;
+    }
+
+    /**
+     * @brief Records where the directory was saved, releasing its previous slot
+     */
+    void set_directory(PageSlot slot, uint32_t crc) {
+        release(directory_);
+        directory_ = slot;
+        directory_crc_ = crc;
+    }
+
+    /**
+     * @brief Rebuilds the free extents after loading
+     * @details Every sector not covered by a page, chunk or directory slot
+     *          is free; the file ends after the last referenced slot.
+     */
+    void rebuild_free_space() {
+        std::vector<PageSlot> used;
+        for (uint64_t entry : entries_) {
+            PageSlot slot = PageSlot::unpack(entry);
+            if (!slot.empty()) {
+                used.push_back(slot);
+                stored_bytes_ += slot.length;
+            }
+        }
+        for (const PageSlot& slot : chunk_slots_) {
+            if (!slot.empty()) {
+                used.push_back(slot);
+            }
+        }
+        if (!directory_.empty()) {
+            used.push_back(directory_);
+        }
+        std::sort(used.begin(), used.end(), [](const PageSlot& a, const PageSlot& b) { return a.sector < b.sector; });
+
+        free_extents_.clear();
+        uint64_t position = first_sector_;
+        for (const PageSlot& slot : used) {
+            if (slot.sector < position) {
+                throw std::runtime_error("Overlapping page slots at sector " + std::to_string(slot.sector));
+            }
+            if (slot.sector > position) {
+                free_extents_.emplace(position, slot.sector - position);
+            }
+            position = slot.sector + slot.sectors();
+        }
+        end_sector_ = position;
+        fresh_.clear();
+        pending_.clear();
+        std::fill(dirty_chunks_.begin(), dirty_chunks_.end(), false);
+    }
+
+    /**
+     * @brief One past the last byte of the last slot (the used part of the file)
+     */
+    [[nodiscard]] uint64_t end_offset() const noexcept {
+        return end_sector_ * SECTOR_SIZE;
+    }
+
+    /**
+     * @brief Total stored bytes of all pages (excluding sector padding)
+     */
+    [[nodiscard]] uint64_t stored_bytes() const noexcept {
+        return stored_bytes_;
+    }
+
+private:
+    static constexpr std::size_t DIRECTORY_ENTRY_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+
+    void mark_dirty(uint64_t chunk) {
+        if (dirty_chunks_.size() <= chunk) {
+            dirty_chunks_.resize(chunk + 1, false);
+        }
+        dirty_chunks_[chunk] = true;
+    }
+
+    /**
+     * @brief Returns sectors to the free extents, merging with neighbours
+     */
+    void free_sectors(uint64_t sector, uint64_t count) {
+        if (sector + count == end_sector_) {
+            end_sector_ = sector;  // Trailing space: the file may end earlier
+            auto last = free_extents_.empty() ? free_extents_.end() : std::prev(free_extents_.end());
+            if (last != free_extents_.end() && last->first + last->second == end_sector_) {
+                end_sector_ = last->first;
+                free_extents_.erase(last);
+            }
+            return;
+        }
+
+        auto next = free_extents_.lower_bound(sector);
+        if (next != free_extents_.end() && sector + count == next->first) {
+            count += next->second;
+            next = free_extents_.erase(next);
+        }
+        if (next != free_extents_.begin()) {
+            auto previous = std::prev(next);
+            if (previous->first + previous->second == sector) {
+                previous->second += count;
+                return;
+            }
+        }
+        free_extents_.emplace(sector, count);
+    }
+
+    uint64_t first_sector_;                     ///< First sector after page 0
+    uint64_t end_sector_;                       ///< One past the last sector in use
+    std::vector<uint64_t> entries_;             ///< Packed slot per page ID
+    std::vector<PageSlot> chunk_slots_;         ///< Where each chunk was last saved
+    std::vector<uint32_t> chunk_crcs_;          ///< CRC32C of each saved chunk
+    std::vector<bool> dirty_chunks_;            ///< Chunks changed since they were saved
+    PageSlot directory_;                        ///< Where the chunk directory was last saved
+    uint32_t directory_crc_;                    ///< CRC32C of the saved directory
+    std::map<uint64_t, uint64_t> free_extents_; ///< Free sectors: first sector -> count
+    std::unordered_set<uint64_t> fresh_;        ///< Slots allocated since the last commit (by sector)
+    std::vector<PageSlot> pending_;             ///< Released slots the saved map may still reference
+    uint64_t stored_bytes_;                     ///< Sum of page slot lengths
+};
+
+inline uint64_t PageSlot::offset() const noexcept {
+    return sector * PageMap::SECTOR_SIZE;
+}
+
+inline uint64_t PageSlot::sectors() const noexcept {
+    return (length + PageMap::SECTOR_SIZE - 1) / PageMap::SECTOR_SIZE;
+}
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_PAGE_MAP_HPP
@@ -0,0 +1,100 @@
+#ifndef LEARNQL_STORAGE_PAGE_SPACE_TRACKER_HPP
+#define LEARNQL_STORAGE_PAGE_SPACE_TRACKER_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <set>
+#include <unordered_map>
+#include <optional>
+#include <utility>
+
+namespace learnql::storage {
+
+/**
+ * @brief In-memory index of the free bytes in a table's slotted pages
+ * @details Lets an insert find a page with room for its record without
+ *          reading pages. Pages are looked up best-fit (the page with the
+ *          least free space that still fits), which keeps big gaps for big
+ *          records and fills pages up before new ones are allocated.
+ *
+ * Pages with less than MIN_FREE bytes free are not tracked; nothing useful
+ * fits there. The tracker is not persisted: after a reopen a table starts
+ * filling new pages, and reused pages come back as records are removed or
+ * updated.
+ *
+ * Example:
+ * @code
+ * PageSpaceTracker space;
+ * space.update(page_id, SlottedPage::free_space(*page));
+ * if (auto page_id = space.find(record.size())) { ... }
+ * @endcode
+ */
+class PageSpaceTracker {
+public:
+    /**
+     * @brief Smallest amount of free space worth tracking
+     */
+    static constexpr std::size_t MIN_FREE = 32;
+
+    PageSpaceTracker() : by_space_{}, space_of_{} {}
+
+    /**
+     * @brief Records a page's current free space
+     * @param page_id Page
+     * @param free_bytes Largest record the page accepts
+     */
+    void update(uint64_t page_id, std::size_t free_bytes) {
+        remove(page_id);
+        if (free_bytes >= MIN_FREE) {
+            by_space_.emplace(free_bytes, page_id);
+            space_of_.emplace(page_id, free_bytes);
+        }
+    }
+
+    /**
+     * @brief Stops tracking a page (e.g. it was deallocated)
+     */
+    void remove(uint64_t page_id) {
+        auto it = space_of_.find(page_id);
+        if (it != space_of_.end()) {
+            by_space_.erase({it->second, page_id});
+            space_of_.erase(it);
+        }
+    }
+
+    /**
+     * @brief Finds the page with the least free space that fits a record
+     * @param bytes Record size
+     * @return Page ID, or std::nullopt if no tracked page has room
+     */
+    [[nodiscard]] std::optional<uint64_t> find(std::size_t bytes) const {
+        auto it = by_space_.lower_bound({bytes, 0});
+        if (it == by_space_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Forgets all pages
+     */
+    void clear() noexcept {
+        by_space_.clear();
+        space_of_.clear();
+    }
+
+    /**
+     * @brief Number of pages tracked
+     */
+    [[nodiscard]] std::size_t size() const noexcept {
+        return space_of_.size();
+    }
+
+private:
+    std::set<std::pair<std::size_t, uint64_t>> by_space_;      ///< (free bytes, page) ordered for best fit
+    std::unordered_map<uint64_t, std::size_t> space_of_;        ///< Free bytes per tracked page
+};
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_PAGE_SPACE_TRACKER_HPP
@@ -0,0 +1,432 @@
+#ifndef LEARNQL_STORAGE_SLOTTED_PAGE_HPP
+#define LEARNQL_STORAGE_SLOTTED_PAGE_HPP
+
+#include "Page.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <span>
+#include <optional>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <array>
+
+namespace learnql::storage {
+
+/**
+ * @brief Slotted-page layout for DATA pages holding many records
+ * @details A view over a Page; it owns nothing. The data section holds a
+ *          record heap growing up from the header and a slot directory
+ *          growing down from the end of the page:
+ *
+ * @code
+ * | PageHeader | rec 0 | rec 2 | rec 1 |  free  | slot 2 | slot 1 | slot 0 |
+ *                                     ^ free_space_offset
+ * @endcode
+ *
+ * - PageHeader::record_count is the number of slots in the directory and
+ *   PageHeader::free_space_offset the end of the heap (from the start of
+ *   the page); PAGE_FLAG_SLOTTED marks the layout
+ * - A slot is SLOT_SIZE bytes: heap offset, length and flags. Its index is
+ *   the record's RecordId::slot and never changes while the record lives
+ * - A removed record frees its slot for reuse; the heap is compacted only
+ *   when an insert or a growing update needs the space
+ * - A record that outgrows its page moves to another page; its home slot
+ *   keeps a Forward stub (SLOT_FORWARD) to the new slot (SLOT_MOVED)
+ *
+ * DATA pages written before this layout hold one record at offset 0 (slot
+ * 0). They are read as such, and converted in place the first time a
+ * SlottedPage is created over them.
+ *
+ * Example:
+ * @code
+ * auto page = engine.new_page(PageType::DATA);
+ * SlottedPage slotted(*page);
+ * auto slot = slotted.insert(writer.get_buffer());   // std::nullopt if full
+ * BinaryReader reader(SlottedPage::read(*page, *slot));
+ * @endcode
+ */
+class SlottedPage {
+public:
+    /**
+     * @brief Bytes per slot directory entry
+     */
+    static constexpr std::size_t SLOT_SIZE = 6;
+
+    /**
+     * @brief Slot flag: the slot holds a record (clear = free slot)
+     */
+    static constexpr uint16_t SLOT_LIVE = 0x0001;
+
+    /**
+     * @brief Slot flag: the slot holds an OverflowHead; the record itself is
+     *        in a chain of overflow pages (see OverflowChain)
+     */
+    static constexpr uint16_t SLOT_OVERFLOW = 0x0002;
+
+    /**
+     * @brief Slot flag: the slot holds a Forward stub pointing at the slot
+     *        the record was moved to when it outgrew this page
+     */
+    static constexpr uint16_t SLOT_FORWARD = 0x0004;
+
+    /**
+     * @brief Slot flag: the slot holds a record moved out of its home slot
+     *        (reached only through the home slot's Forward stub)
+     */
+    static constexpr uint16_t SLOT_MOVED = 0x0008;
+
+    /**
+     * @brief Forwarding stub kept in a record's home slot after the record moved
+     * @details Encoded as 12 bytes: page ID (8) then slot (4). The home slot
+     *          keeps the record's RecordId valid, so indexes need no change.
+     */
+    struct Forward {
+        static constexpr std::size_t SIZE = 12;  ///< Encoded size in bytes
+
+        uint64_t page_id;  ///< Page the record moved to
+        uint32_t slot;     ///< Slot the record moved to
+
+        /**
+         * @brief Encodes the stub for storing in a slot
+         */
+        [[nodiscard]] std::array<uint8_t, SIZE> encode() const noexcept {
+            std::array<uint8_t, SIZE> bytes{};
+            std::memcpy(bytes.data(), &page_id, sizeof(page_id));
+            std::memcpy(bytes.data() + sizeof(page_id), &slot, sizeof(slot));
+            return bytes;
+        }
+
+        /**
+         * @brief Decodes a stub read from a slot
+         * @throws std::runtime_error if the bytes are not a stub
+         */
+        [[nodiscard]] static Forward decode(std::span<const uint8_t> bytes) {
+            if (bytes.size() < SIZE) {
+                throw std::runtime_error("Invalid forwarding stub");
+            }
+            Forward forward{};
+            std::memcpy(&forward.page_id, bytes.data(), sizeof(forward.page_id));
+            std::memcpy(&forward.slot, bytes.data() + sizeof(forward.page_id), sizeof(forward.slot));
+            return forward;
+        }
+    };
+
+    /**
+     * @brief Opens a page as a slotted page, converting an empty or legacy page
+     * @param page DATA page to work on (must outlive the view)
+     */
+    explicit SlottedPage(Page& page) : page_{page} {
+        if (!is_slotted(page_)) {
+            adopt(page_);
+        }
+    }
+
+    /**
+     * @brief Checks whether a page uses the slotted layout
+     */
+    [[nodiscard]] static bool is_slotted(const Page& page) noexcept {
+        return (page.header().flags & PAGE_FLAG_SLOTTED) != 0;
+    }
+
+    /**
+     * @brief Largest record a page of the given size can hold
+     */
+    [[nodiscard]] static constexpr std::size_t max_record_size(std::size_t page_size) noexcept {
+        return page_size - sizeof(PageHeader) - SLOT_SIZE;
+    }
+
+    /**
+     * @brief Returns a record's bytes
+     * @param page Page holding the record
+     * @param slot Slot of the record
+     * @throws std::runtime_error if the slot holds no record
+     * @details On a legacy (single-record) page slot 0 is the whole data
+     *          section; the record's own encoding tells its length.
+     */
+    [[nodiscard]] static std::span<const uint8_t> read(const Page& page, uint32_t slot) {
+        if (!is_slotted(page)) {
+            if (slot != 0 || page.header().record_count == 0) {
+                throw_missing(page, slot);
+            }
+            return page.data();
+        }
+        Slot entry = slot_at(page, slot);
+        if (!(entry.flags & SLOT_LIVE)) {
+            throw_missing(page, slot);
+        }
+        return page.data().subspan(entry.offset, entry.length);
+    }
+
+    /**
+     * @brief Returns a slot's SLOT_* flags (0 for a free or missing slot)
+     */
+    [[nodiscard]] static uint16_t slot_flags(const Page& page, uint32_t slot) noexcept {
+        if (!is_slotted(page)) {
+            return slot == 0 && page.header().record_count > 0 ? SLOT_LIVE : 0;
+        }
+        return slot < page.header().record_count ? slot_at(page, slot).flags : 0;
+    }
+
+    /**
+     * @brief Size of the largest record an insert into the page would accept
+     * @param page Page to check (legacy pages count as full)
+     */
+    [[nodiscard]] static std::size_t free_space(const Page& page) noexcept {
+        if (!is_slotted(page)) {
+            return 0;
+        }
+        std::size_t slots = page.header().record_count;
+        std::size_t free = directory_start(page, slots) - page.header().free_space_offset + dead_bytes(page);
+        bool slot_free = false;
+        for (std::size_t i = 0; i < slots && !slot_free; ++i) {
+            slot_free = !(slot_at(page, static_cast<uint32_t>(i)).flags & SLOT_LIVE);
+        }
+        std::size_t needed = slot_free ? 0 : SLOT_SIZE;
+        return free > needed ? free - needed : 0;
+    }
+
+    /**
+     * @brief Number of slots in the directory (live and free)
+     */
+    [[nodiscard]] uint32_t slot_count() const noexcept {
+        return page_.header().record_count;
+    }
+
+    /**
+     * @brief Number of live records
+     */
+    [[nodiscard]] std::size_t live_count() const noexcept {
+        std::size_t live = 0;
+        for (uint32_t i = 0; i < slot_count(); ++i) {
+            live += (slot_at(page_, i).flags & SLOT_LIVE) ? 1 : 0;
+        }
+        return live;
+    }
+
+    /**
+     * @brief Adds a record
+     * @param record Record bytes
+     * @param flags SLOT_* flags to set besides SLOT_LIVE
+     * @return The record's slot, or std::nullopt if the page cannot hold it
+     */
+    [[nodiscard]] std::optional<uint32_t> insert(std::span<const uint8_t> record, uint16_t flags = 0) {
+        uint32_t slot = 0;
+        while (slot < slot_count() && (slot_at(page_, slot).flags & SLOT_LIVE)) {
+            ++slot;
+        }
+        bool new_slot = slot == slot_count();
+        if (!reserve(record.size() + (new_slot ? SLOT_SIZE : 0))) {
+            return std::nullopt;
+        }
+        if (new_slot) {
+            ++page_.header().record_count;
+        }
+        append(slot, record, flags);
+        return slot;
+    }
+
+    /**
+     * @brief Checks whether update() would succeed
+     * @param slot Slot of the record
+     * @param size Size of the new record
+     * @throws std::runtime_error if the slot holds no record
+     */
+    [[nodiscard]] bool can_update(uint32_t slot, std::size_t size) const {
+        Slot entry = live_slot(slot);
+
+        // The old bytes count as free space for a move within the page
+        return size <= entry.length || contiguous_free() >= size ||
+               contiguous_free() + dead_bytes(page_) + entry.length >= size;
+    }
+
+    /**
+     * @brief Replaces a record, in place when it still fits
+     * @param slot Slot of the record
+     * @param record New record bytes
+     * @param flags SLOT_* flags to set besides SLOT_LIVE (replacing the old ones)
+     * @return false if the page cannot hold the new record (nothing changes)
+     * @throws std::runtime_error if the slot holds no record
+     */
+    bool update(uint32_t slot, std::span<const uint8_t> record, uint16_t flags = 0) {
+        Slot entry = live_slot(slot);
+        if (record.size() <= entry.length) {
+            page_.write_data(entry.offset, record.data(), record.size());
+            set_slot(slot, Slot{entry.offset, static_cast<uint16_t>(record.size()),
+                                static_cast<uint16_t>(SLOT_LIVE | flags)});
+            return true;
+        }
+
+        if (!can_update(slot, record.size())) {
+            return false;
+        }
+        set_slot(slot, Slot{0, 0, entry.flags});
+        reserve(record.size());
+        append(slot, record, flags);
+        return true;
+    }
+
+    /**
+     * @brief Removes a record, freeing its slot
+     * @param slot Slot of the record
+     * @throws std::runtime_error if the slot holds no record
+     */
+    void erase(uint32_t slot) {
+        (void)live_slot(slot);
+        set_slot(slot, Slot{0, 0, 0});
+
+        // Trailing free slots leave the directory
+        uint16_t& count = page_.header().record_count;
+        while (count > 0 && !(slot_at(page_, count - 1u).flags & SLOT_LIVE)) {
+            --count;
+        }
+        if (count == 0) {
+            page_.header().free_space_offset = sizeof(PageHeader);
+        }
+    }
+
+private:
+    /**
+     * @brief One slot directory entry
+     */
+    struct Slot {
+        uint16_t offset;  ///< Start of the record in the data section
+        uint16_t length;  ///< Record length in bytes
+        uint16_t flags;   ///< SLOT_* bits
+    };
+
+    /**
+     * @brief Gets the page offset where the directory of the given size starts
+     */
+    [[nodiscard]] static std::size_t directory_start(const Page& page, std::size_t slots) noexcept {
+        return page.size() - slots * SLOT_SIZE;
+    }
+
+    [[nodiscard]] static Slot slot_at(const Page& page, uint32_t slot) noexcept {
+        const auto* bytes = static_cast<const uint8_t*>(page.raw_data()) + directory_start(page, slot + 1u);
+        Slot entry{};
+        std::memcpy(&entry.offset, bytes, 2);
+        std::memcpy(&entry.length, bytes + 2, 2);
+        std::memcpy(&entry.flags, bytes + 4, 2);
+        return entry;
+    }
+
+    void set_slot(uint32_t slot, const Slot& entry) noexcept {
+        auto* bytes = static_cast<uint8_t*>(page_.raw_data()) + directory_start(page_, slot + 1u);
+        std::memcpy(bytes, &entry.offset, 2);
+        std::memcpy(bytes + 2, &entry.length, 2);
+        std::memcpy(bytes + 4, &entry.flags, 2);
+    }
+
+    /**
+     * @brief Bytes of the heap no live record uses (reclaimed by compact())
+     */
+    [[nodiscard]] static std::size_t dead_bytes(const Page& page) noexcept {
+        std::size_t used = page.header().free_space_offset - sizeof(PageHeader);
+        std::size_t live = 0;
+        for (uint32_t i = 0; i < page.header().record_count; ++i) {
+            Slot entry = slot_at(page, i);
+            live += (entry.flags & SLOT_LIVE) ? entry.length : 0;
+        }
+        return used - live;
+    }
+
+    /**
+     * @brief Bytes between the end of the heap and the directory
+     */
+    [[nodiscard]] std::size_t contiguous_free() const noexcept {
+        return directory_start(page_, slot_count()) - page_.header().free_space_offset;
+    }
+
+    [[nodiscard]] Slot live_slot(uint32_t slot) const {
+        if (slot >= slot_count() || !(slot_at(page_, slot).flags & SLOT_LIVE)) {
+            throw_missing(page_, slot);
+        }
+        return slot_at(page_, slot);
+    }
+
+    /**
+     * @brief Makes room for bytes at the end of the heap, compacting if needed
+     * @param bytes Heap bytes plus the new directory entry, if any
+     * @return false if the page cannot provide them
+     */
+    bool reserve(std::size_t bytes) {
+        if (contiguous_free() >= bytes) {
+            return true;
+        }
+        if (contiguous_free() + dead_bytes(page_) < bytes) {
+            return false;
+        }
+        compact();
+        return true;
+    }
+
+    /**
+     * @brief Writes a record at the end of the heap and points a slot at it
+     */
+    void append(uint32_t slot, std::span<const uint8_t> record, uint16_t flags) {
+        std::size_t offset = page_.header().free_space_offset - sizeof(PageHeader);
+        page_.write_data(offset, record.data(), record.size());
+        set_slot(slot, Slot{static_cast<uint16_t>(offset), static_cast<uint16_t>(record.size()),
+                            static_cast<uint16_t>(SLOT_LIVE | flags)});
+        page_.header().free_space_offset = static_cast<uint16_t>(page_.header().free_space_offset + record.size());
+    }
+
+    /**
+     * @brief Moves the live records to the start of the heap, in heap order
+     */
+    void compact() {
+        std::vector<std::pair<uint16_t, uint32_t>> live;  // (offset, slot)
+        for (uint32_t i = 0; i < slot_count(); ++i) {
+            Slot entry = slot_at(page_, i);
+            if (entry.flags & SLOT_LIVE) {
+                live.emplace_back(entry.offset, i);
+            }
+        }
+        std::sort(live.begin(), live.end());
+
+        // Moving down in offset order never overwrites a record not yet moved
+        std::size_t end = 0;
+        uint8_t* heap = page_.data().data();
+        for (const auto& [offset, slot] : live) {
+            Slot entry = slot_at(page_, slot);
+            std::memmove(heap + end, heap + offset, entry.length);
+            set_slot(slot, Slot{static_cast<uint16_t>(end), entry.length, entry.flags});
+            end += entry.length;
+        }
+        page_.header().free_space_offset = static_cast<uint16_t>(sizeof(PageHeader) + end);
+    }
+
+    /**
+     * @brief Converts an empty or single-record page to the slotted layout
+     * @details A legacy record's exact length is not stored (updates kept
+     *          the old free_space_offset), so it keeps the whole data
+     *          section until its next update or removal.
+     */
+    static void adopt(Page& page) {
+        bool has_record = page.header().record_count > 0;
+        page.header().flags |= PAGE_FLAG_SLOTTED;
+        page.header().record_count = 0;
+        page.header().free_space_offset = sizeof(PageHeader);
+        if (has_record) {
+            uint16_t length = static_cast<uint16_t>(max_record_size(page.size()));
+            page.header().record_count = 1;
+            page.header().free_space_offset = static_cast<uint16_t>(sizeof(PageHeader) + length);
+            SlottedPage view(page);
+            view.set_slot(0, Slot{0, length, SLOT_LIVE});
+        }
+    }
+
+    [[noreturn]] static void throw_missing(const Page& page, uint32_t slot) {
+        throw std::runtime_error("No record in slot " + std::to_string(slot) + " of page " +
+                                 std::to_string(page.header().page_id));
+    }
+
+    Page& page_;  ///< Page being viewed
+};
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_SLOTTED_PAGE_HPP
@@ -2,178 +2,420 @@
 #define LEARNQL_STORAGE_STORAGE_ENGINE_HPP
 
 #include "Page.hpp"
+#include "FileHandle.hpp"
+#include "MappedFile.hpp"
+#include "StorageOptions.hpp"
+#include "BufferPool.hpp"
+#include "PageGuard.hpp"
+#include "IoStats.hpp"
+#include "WriteAheadLog.hpp"
+#include "FreeSpaceMap.hpp"
+#include "AsyncIo.hpp"
+#include "PageMap.hpp"
+#include "LzCodec.hpp"
+#include "MemoryGovernor.hpp"
 #include <string>
-#include <fstream>
 #include <memory>
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
+#include <unordered_map>
 #include <filesystem>
 #include <stdexcept>
 #include <algorithm>
 #include <ctime>
+#include <utility>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <chrono>
+#include <span>
+#include <system_error>
+#include <cerrno>
 
 namespace learnql::storage {
 
 /**
  * @brief Storage engine managing pages and file I/O
- * @details Provides page-based storage with free list management
+ * @details Provides page-based storage with bitmap free space management
  *
  * Features:
- * - Page allocation and deallocation
- * - Free list management for reusing deleted pages
- * - Page caching for performance
- * - RAII file handling
+ * - Page allocation and deallocation, including contiguous runs
+ * - Free space bitmap kept in memory: allocating and freeing never read a page
+ * - Buffer pool with pinning and scan-resistant CLOCK (2Q) replacement
+ * - Zero-copy page access through RAII guards (PageRef / PageGuard)
+ * - RAII file handling (one descriptor for the engine's lifetime)
+ * - Positional I/O (pread/pwrite) - no seeks, no reopen per access
  * - Transaction-like flush operations
+ * - Allocation metadata kept in memory and persisted at flush time
+ * - Sorted, coalesced write-back (adjacent dirty pages in one pwritev)
+ * - Read-only mode, optionally served from a shared memory mapping
+ * - CRC32C page checksums, written on every write-back and verified on read
+ * - Optional write-ahead log: commits append page images and group their
+ *   fsyncs; pages are written in place at checkpoints; redo runs at open
+ * - Optional background writer that trickles dirty pages out between
+ *   watermarks, so foreground calls stall only at a hard limit
+ * - Page size chosen when the database is created (4KB-64KB) and recorded
+ *   in page 0
+ * - Optional io_uring (or thread pool) backend: a flush submits all its
+ *   runs at once and prefetch_pages() reads a batch of pages together
+ * - Sequential readahead: forward scans get the next pages read in one
+ *   batch ahead of the cursor (StorageOptions::readahead_pages)
+ * - Optional direct I/O (O_DIRECT), making the buffer pool the only cache
+ * - File growth in reserved chunks (fallocate), with a size hint for new
+ *   databases
+ * - Optional page compression (StorageOptions::compression): pages are
+ *   compressed at write-back and stored in variable-size slots
+ * - Resizable buffer pool (resize_cache()), sized by a MemoryGovernor
+ *   when one is attached
+ *
+ * Thread safety: the engine can be shared between threads. Fetching a
+ * page that is already cached takes no engine lock: the buffer pool's page
+ * table is split into independently locked partitions, pin counts are
+ * atomic, and each frame has a reader/writer latch held by its guard
+ * (shared for PageRef, exclusive for PageGuard). Misses, allocation,
+ * write-back and the other public methods still serialize on the engine
+ * lock, which is never held while waiting for a frame latch. Write-back
+ * skips pages another thread holds for writing; they go out next time.
+ * A thread must not hold a PageGuard on a page while fetching it again.
  *
  * File Layout:
- * - Page 0: Metadata page (database info, free list head, etc.)
- * - Page 1+: Data pages
+ * - Page 0: Metadata page (database info, catalog roots, bitmap of the
+ *   first page group)
+ * - Page 1+: Data pages, plus one FREE_SPACE_MAP page per further group
+ *   of FreeSpaceMap::pages_per_group() pages
+ *
+ * In a compressed database page N is not at N * page size: page 0 stays
+ * at offset 0 and the other pages live in slots placed by the PageMap,
+ * which is saved with the metadata at flush time.
  */
 class StorageEngine {
 public:
     /**
      * @brief Creates or opens a database file
      * @param file_path Path to the database file
-     * @param cache_size Number of pages to cache in memory
+     * @param cache_size Number of buffer pool frames (pages cached in memory)
      * @throws std::runtime_error if file cannot be opened
      */
     explicit StorageEngine(const std::string& file_path, std::size_t cache_size = 64)
-        : file_path_{file_path},
-          next_page_id_{1},
-          free_list_head_{0},
+        : StorageEngine(file_path, StorageOptions{.cache_size = cache_size}) {}
+
+    /**
+     * @brief Creates or opens a database file with explicit options
+     * @param file_path Path to the database file
+     * @param options Open mode, cache size and validation settings
+     * @throws std::runtime_error if file cannot be opened (or, in read-only
+     *         mode, does not exist)
+     * @throws std::invalid_argument if memory_map is set without read_only,
+     *         a new database is given an unsupported page size, or a
+     *         compressed database is opened with enable_wal or memory_map
+     */
+    StorageEngine(const std::string& file_path, const StorageOptions& options)
+        : options_{options},
+          file_path_{file_path},
+          file_{},
+          mapping_{},
+          wal_{},
+          async_io_{},
+          direct_io_{false},
           sys_tables_root_{0},
           sys_fields_root_{0},
           sys_indexes_root_{0},
-          cache_size_{cache_size},
-          page_cache_{},
-          dirty_pages_{} {
+          metadata_dirty_{false},
+          page_size_{stored_page_size(file_path, options)},
+          compression_{stored_compression(file_path, options)},
+          free_space_{page_size_},
+          page_map_{page_size_},
+          reserved_pages_{0},
+          can_reserve_{!options.read_only},
+          last_access_page_{0},
+          sequential_accesses_{0},
+          readahead_end_{0},
+          cache_size_{options.cache_size},
+          pool_{options.memory_map ? 1 : options.cache_size, page_size_, options.replacement},
+          governor_{},
+          cache_budget_{},
+          mapped_views_{},
+          io_stats_{},
+          mutex_{},
+          writer_wakeup_{},
+          writer_{},
+          writer_io_mutex_{},
+          writer_images_{},
+          stop_writer_{false} {
+
+        if (options_.memory_map && !options_.read_only) {
+            throw std::invalid_argument("memory_map requires read_only");
+        }
+        if (options_.memory_map && options_.direct_io) {
+            throw std::invalid_argument("direct_io cannot be combined with memory_map");
+        }
+        if (is_compressed() && options_.memory_map) {
+            throw std::invalid_argument("memory_map cannot be used with a compressed database");
+        }
+        if (is_compressed() && options_.enable_wal && !options_.read_only) {
+            throw std::invalid_argument("enable_wal cannot be used with a compressed database");
+        }
 
-        // Create or open the file
-        if (std::filesystem::exists(file_path_)) {
+        // Create or open the file (kept open until the engine is destroyed)
+        bool created = false;
+        if (options_.read_only) {
+            if (!std::filesystem::exists(file_path_)) {
+                throw std::runtime_error("Cannot open read-only database: " + file_path_ + " does not exist");
+            }
+            if (WriteAheadLog::has_records(WriteAheadLog::path_for(file_path_))) {
+                throw std::runtime_error("Database " + file_path_ +
+                                         " has unrecovered log records; open it read-write once first");
+            }
+            file_ = FileHandle(file_path_, FileHandle::read_only_flags());
+            if (options_.memory_map) {
+                mapping_ = MappedFile(file_);
+            }
+            load_metadata();
+        } else if (std::filesystem::exists(file_path_)) {
+            file_ = FileHandle(file_path_, FileHandle::read_write_flags());
+            open_wal(false);
             load_metadata();
         } else {
+            file_ = FileHandle(file_path_, FileHandle::create_flags());
             create_new_database();
+            open_wal(true);
+            created = true;
+        }
+
+        reserved_pages_ = file_.size() / page_size_;
+        if (created && options_.size_hint_bytes > 0) {
+            reserve_to((options_.size_hint_bytes + page_size_ - 1) / page_size_);
+        }
+
+        // Recovery and metadata reads above use small unaligned transfers,
+        // so the page-cache bypass only starts once the file is open.
+        // Compressed slots are sector-sized, so they stay buffered.
+        if (options_.direct_io && !is_compressed()) {
+            reopen_direct();
+        }
+
+        if (!options_.memory_map) {
+            async_io_ = make_async_io(options_.io_backend, file_.native_handle(),
+                                      options_.io_queue_depth, options_.io_threads);
+        }
+
+        if (options_.background_writer && !options_.read_only) {
+            start_writer();
         }
     }
 
     /**
-     * @brief Destructor - flushes all dirty pages
+     * @brief Destructor - checkpoints (writes every page in place)
      */
     ~StorageEngine() {
+        stop_writer();
         try {
-            flush_all();
+            checkpoint();
         } catch (...) {
             // Suppress exceptions in destructor
         }
     }
 
-    // Disable copy (file handle is unique)
+    // Disable copy and move (file handle is unique; the writer thread and
+    // page guards refer to this object)
     StorageEngine(const StorageEngine&) = delete;
     StorageEngine& operator=(const StorageEngine&) = delete;
-
-    // Allow move
-    StorageEngine(StorageEngine&&) noexcept = default;
-    StorageEngine& operator=(StorageEngine&&) noexcept = default;
+    StorageEngine(StorageEngine&&) = delete;
+    StorageEngine& operator=(StorageEngine&&) = delete;
 
     /**
      * @brief Allocates a new page
      * @param type Type of page to allocate
      * @return Page ID of the allocated page
-     * @details Uses free list if available, otherwise allocates new page
+     * @details Reuses the lowest free page, otherwise extends the file
      */
     [[nodiscard]] uint64_t allocate_page(PageType type = PageType::DATA) {
-        uint64_t page_id;
-
-        // Try to reuse a free page
-        if (free_list_head_ != 0) {
-            page_id = free_list_head_;
-            auto page = read_page(page_id);
-            free_list_head_ = page.header().next_page_id;
+        return new_page(type).page_id();
+    }
 
-            // Reset the page
-            page = Page(page_id, type);
-            write_page(page_id, page);
-        } else {
-            // Allocate a new page
-            page_id = next_page_id_++;
-            Page page(page_id, type);
-            write_page(page_id, page);
+    /**
+     * @brief Allocates a new page and returns it pinned for writing
+     * @param type Type of page to allocate
+     * @return Guard on the freshly initialized page (marked dirty on release)
+     * @details Same as allocate_page(), but the caller can fill the page in
+     *          place instead of reading it back and writing a copy.
+     */
+    [[nodiscard]] PageGuard new_page(PageType type = PageType::DATA) {
+        uint64_t page_id;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            ensure_writable();
+            page_id = reserve_pages(1);
         }
+        return reset_page(page_id, type);
+    }
 
-        // Update metadata
-        save_metadata();
-
-        return page_id;
+    /**
+     * @brief Allocates contiguous pages
+     * @param count Number of pages
+     * @param type Type of the new pages
+     * @return Page ID of the first page (the run is first..first+count-1)
+     * @throws std::invalid_argument if count is zero
+     * @details The pages are initialized in the buffer pool without reading
+     *          the file, so a bulk load can fill them and have them written
+     *          back as one sequential run.
+     *
+     * Example:
+     * @code
+     * uint64_t first = engine.allocate_pages(16, PageType::DATA);
+     * for (uint64_t id = first; id < first + 16; ++id) {
+     *     auto page = engine.fetch_page_mut(id);  // Cached unless already written back
+     *     // ... fill page
+     * }
+     * @endcode
+     */
+    [[nodiscard]] uint64_t allocate_pages(std::size_t count, PageType type = PageType::DATA) {
+        uint64_t first;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            ensure_writable();
+            first = reserve_pages(count);
+        }
+        for (uint64_t page_id = first; page_id < first + count; ++page_id) {
+            PageGuard page = reset_page(page_id, type);  // Unpinned dirty at the end of the iteration
+        }
+        return first;
     }
 
     /**
-     * @brief Deallocates a page (adds to free list)
+     * @brief Deallocates a page
      * @param page_id ID of the page to deallocate
+     * @throws std::invalid_argument for page 0, a free space map page or a
+     *         page that is not allocated
+     * @details Only the page's bit is cleared. The page itself is neither
+     *          read nor written; a cached copy is dropped.
      */
     void deallocate_page(uint64_t page_id) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         if (page_id == 0) {
             throw std::invalid_argument("Cannot deallocate metadata page");
         }
+        ensure_writable();
 
-        // Read the page and mark it as free
-        auto page = read_page(page_id);
-        page.header().page_type = PageType::FREE;
-        page.header().next_page_id = free_list_head_;
-        page.clear();
-
-        // Add to free list
-        free_list_head_ = page_id;
-        write_page(page_id, page);
+        free_space_.release(page_id);
+        if (is_compressed()) {
+            page_map_.assign(page_id, PageSlot{});
+        }
+        metadata_dirty_ = true;
 
-        // Update metadata
-        save_metadata();
+        std::size_t frame_id = pool_.lookup(page_id);
+        if (frame_id != BufferPool::INVALID_FRAME) {
+            pool_.try_evict(frame_id, true);  // Left alone if pinned
+        }
     }
 
     /**
-     * @brief Reads a page from storage
-     * @param page_id ID of the page to read
-     * @return The page
-     * @throws std::runtime_error if page cannot be read
+     * @brief Checks whether a page is allocated
+     * @param page_id ID of the page
+     * @return true for page 0, free space map pages and pages in use
      */
-    [[nodiscard]] Page read_page(uint64_t page_id) {
-        // Check cache first
-        auto it = page_cache_.find(page_id);
-        if (it != page_cache_.end()) {
-            return it->second;
-        }
+    [[nodiscard]] bool is_page_allocated(uint64_t page_id) const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return free_space_.is_allocated(page_id);
+    }
 
-        // Read from file
-        std::ifstream file(file_path_, std::ios::binary);
-        if (!file) {
-            throw std::runtime_error("Cannot open file for reading: " + file_path_);
+    /**
+     * @brief Pins a page for reading without copying it
+     * @param page_id ID of the page
+     * @return Read-only guard on the cached page
+     * @throws std::runtime_error if page cannot be read or all frames are pinned
+     */
+    [[nodiscard]] PageRef fetch_page(uint64_t page_id) {
+        if (BufferPool::Frame* frame = pin_cached(page_id)) {
+            return PageRef(&pool_, frame);
         }
 
-        // Seek to page
-        file.seekg(static_cast<std::streamoff>(page_id * PAGE_SIZE));
-        if (!file) {
-            throw std::runtime_error("Cannot seek to page " + std::to_string(page_id));
+        BufferPool::Frame* frame;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            if (mapping_.is_mapped()) {
+                return PageRef(mapped_page(page_id));
+            }
+            frame = &pool_.frame(fetch_frame(page_id, true));
         }
+        return PageRef(&pool_, frame);  // Latched outside the engine lock
+    }
 
-        // Read page
-        Page page;
-        file.read(static_cast<char*>(page.raw_data()), PAGE_SIZE);
-        if (!file) {
-            throw std::runtime_error("Cannot read page " + std::to_string(page_id));
+    /**
+     * @brief Pins a page for modification without copying it
+     * @param page_id ID of the page
+     * @return Mutable guard on the cached page (marked dirty on release)
+     * @throws std::runtime_error if page cannot be read or all frames are pinned
+     */
+    [[nodiscard]] PageGuard fetch_page_mut(uint64_t page_id) {
+        BufferPool::Frame* frame;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            ensure_writable();
+            flush_if_needed();
+            frame = &pool_.frame(fetch_frame(page_id, true));
         }
+        return PageGuard(&pool_, frame);  // Latched outside the engine lock
+    }
 
-        // Validate page
-        if (!page.header().is_valid()) {
-            throw std::runtime_error("Invalid page header for page " + std::to_string(page_id));
+    /**
+     * @brief Pins a page that is about to be completely rewritten
+     * @param page_id ID of the page
+     * @param type Page type for the reset header
+     * @return Mutable guard on an empty page (marked dirty on release)
+     * @details The old contents are never read from disk - the frame is
+     *          reinitialized as an empty page of the given type.
+     */
+    [[nodiscard]] PageGuard reset_page(uint64_t page_id, PageType type = PageType::DATA) {
+        BufferPool::Frame* frame;
+        bool latched = false;
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            ensure_writable();
+            flush_if_needed();
+            frame = &pool_.frame(fetch_frame(page_id, false, &latched));
         }
+        PageGuard page(&pool_, frame, latched);
+        page->reset(page_id, type);
+        return page;
+    }
 
-        // Add to cache
-        if (page_cache_.size() >= cache_size_) {
-            evict_page();
+    /**
+     * @brief Reads pages into the buffer pool ahead of use, as one batch
+     * @param page_ids Pages the caller is about to fetch, in the order it needs them
+     * @details Pages already cached, free, or not yet on disk are skipped,
+     *          and at most a quarter of the frames are filled per call. The
+     *          rest are sorted and merged into runs of consecutive pages.
+     *          An asynchronous backend gets all runs in one submission;
+     *          with IoBackend::SYNC each run is one blocking vectored read.
+     *          A page that fails to read or validate is dropped; fetching
+     *          it reports the error.
+     *
+     * Does nothing in memory_map mode.
+     *
+     * Example:
+     * @code
+     * std::vector<uint64_t> next_leaves = {41, 42, 57, 58};
+     * engine.prefetch_pages(next_leaves);
+     * auto leaf = engine.fetch_page(41);  // Served from the buffer pool
+     * @endcode
+     */
+    void prefetch_pages(std::span<const uint64_t> page_ids) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (mapping_.is_mapped()) {
+            return;
         }
-        page_cache_[page_id] = page;
+        read_ahead(page_ids);
+    }
 
-        return page;
+    /**
+     * @brief Reads a page from storage
+     * @param page_id ID of the page to read
+     * @return The page
+     * @throws std::runtime_error if page cannot be read
+     */
+    [[nodiscard]] Page read_page(uint64_t page_id) {
+        PageRef page = fetch_page(page_id);
+        return *page;
     }
 
     /**
@@ -182,91 +424,194 @@ public:
      * @param page The page to write
      */
     void write_page(uint64_t page_id, const Page& page) {
-        // Update cache
-        page_cache_[page_id] = page;
-        dirty_pages_.insert(page_id);
+        // The whole page is overwritten, so a miss does not need a disk read
+        PageGuard frame_page = reset_page(page_id, page.header().page_type);
+        *frame_page = page;
+    }
 
-        // If cache is full, flush immediately
-        if (dirty_pages_.size() > cache_size_ / 2) {
-            flush_all();
+    /**
+     * @brief Pins a page in the buffer pool and returns the cached copy
+     * @param page_id ID of the page to pin
+     * @return Reference to the page inside its frame
+     * @throws std::runtime_error if page cannot be read or all frames are pinned
+     *
+     * The frame cannot be evicted until unpin_page() is called, so the
+     * reference stays valid. Every pin must be matched by exactly one unpin.
+     */
+    [[nodiscard]] Page& pin_page(uint64_t page_id) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        ensure_writable();
+        return pool_.frame(fetch_frame(page_id, true)).page;
+    }
+
+    /**
+     * @brief Releases a pin taken by pin_page()
+     * @param page_id ID of the pinned page
+     * @param dirty true if the page was modified through the reference
+     */
+    void unpin_page(uint64_t page_id, bool dirty) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        std::size_t frame_id = pool_.lookup(page_id);
+        if (frame_id == BufferPool::INVALID_FRAME) {
+            throw std::logic_error("Unpinning page " + std::to_string(page_id) + " that is not resident");
         }
+        pool_.unpin(frame_id, dirty);
     }
 
     /**
-     * @brief Flushes all dirty pages to disk
+     * @brief Flushes all dirty pages and the allocation metadata to disk
+     * @details Crash-safe ordering: every data page is written and synced
+     *          before page 0 is rewritten (and synced), so the metadata on
+     *          disk never refers to pages that have not reached the disk.
+     *          In a compressed database the page map is written with the
+     *          data pages, and slots of the previous map are reused only
+     *          after page 0 points at the new one.
+     *
+     * With the write-ahead log enabled this is a commit() instead: changes
+     * become durable through the log and pages are written at checkpoints.
      */
     void flush_all() {
-        if (dirty_pages_.empty()) {
+        if (wal_.is_open()) {
+            commit();
             return;
         }
 
-        std::fstream file(file_path_, std::ios::binary | std::ios::in | std::ios::out);
-        if (!file) {
-            throw std::runtime_error("Cannot open file for writing: " + file_path_);
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (metadata_dirty_) {
+            stage_free_space_map();
         }
+        write_dirty_pages();
 
-        for (uint64_t page_id : dirty_pages_) {
-            auto it = page_cache_.find(page_id);
-            if (it != page_cache_.end()) {
-                // Update checksum before writing
-                Page page = it->second;
-                page.update_checksum();
+        if (metadata_dirty_) {
+            if (is_compressed()) {
+                save_page_map();
+            }
+            file_.sync();
+            save_metadata();
+            file_.sync();
+            page_map_.commit();  // Slots the old map referenced can now be reused
+        }
+    }
 
-                // Seek and write
-                file.seekp(static_cast<std::streamoff>(page_id * PAGE_SIZE));
-                file.write(static_cast<const char*>(page.raw_data()), PAGE_SIZE);
+    /**
+     * @brief Makes every change so far durable
+     * @details With the write-ahead log, the image of each page modified
+     *          since its last log record (plus page 0 if the metadata
+     *          changed) is appended and the log is synced once; concurrent
+     *          commits share that sync. The log is checkpointed when it grows
+     *          past StorageOptions::wal_checkpoint_bytes.
+     *
+     * Without the log, every dirty page is written in place and synced.
+     */
+    void commit() {
+        if (options_.read_only) {
+            return;
+        }
 
-                if (!file) {
-                    throw std::runtime_error("Cannot write page " + std::to_string(page_id));
-                }
+        if (!wal_.is_open()) {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            ++io_stats_.commits;
+            flush_all();
+            file_.sync();
+            return;
+        }
 
-                // Update cache with checksummed page
-                page_cache_[page_id] = page;
-            }
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            ++io_stats_.commits;
+            stage_metadata();
+            log_dirty_pages();
         }
 
-        file.flush();
-        dirty_pages_.clear();
+        // Sync outside the engine lock so concurrent commits share one fsync
+        wal_.flush();
+
+        if (wal_.size_bytes() > options_.wal_checkpoint_bytes) {
+            checkpoint();
+        }
     }
 
     /**
-     * @brief Flushes a specific page to disk
-     * @param page_id ID of the page to flush
+     * @brief Writes every dirty page in place, syncs and empties the log
+     * @details After a checkpoint the database file alone is complete, so
+     *          the log can start over (its LSNs keep increasing).
      */
-    void flush_page(uint64_t page_id) {
-        if (dirty_pages_.find(page_id) == dirty_pages_.end()) {
-            return; // Not dirty
+    void checkpoint() {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (options_.read_only) {
+            return;
         }
 
-        std::fstream file(file_path_, std::ios::binary | std::ios::in | std::ios::out);
-        if (!file) {
-            throw std::runtime_error("Cannot open file for writing: " + file_path_);
+        if (!wal_.is_open()) {
+            flush_all();
+            file_.sync();
+            return;
         }
 
-        auto it = page_cache_.find(page_id);
-        if (it != page_cache_.end()) {
-            Page page = it->second;
-            page.update_checksum();
-
-            file.seekp(static_cast<std::streamoff>(page_id * PAGE_SIZE));
-            file.write(static_cast<const char*>(page.raw_data()), PAGE_SIZE);
-
-            if (!file) {
-                throw std::runtime_error("Cannot write page " + std::to_string(page_id));
-            }
+        stage_metadata();
+        bool complete = write_dirty_pages();  // Logs and syncs the images first (WAL rule)
+        file_.sync();
+        if (complete) {
+            // A page skipped while another thread was writing it may have its
+            // only durable image in the log, so the log is kept until next time
+            wal_.truncate();
+        }
+        ++io_stats_.checkpoints;
+    }
 
-            page_cache_[page_id] = page;
+    /**
+     * @brief Flushes a specific page to disk
+     * @param page_id ID of the page to flush
+     */
+    void flush_page(uint64_t page_id) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        std::size_t frame_id = pool_.lookup(page_id);
+        if (frame_id == BufferPool::INVALID_FRAME || !pool_.frame(frame_id).dirty) {
+            return; // Not resident or not dirty
         }
 
-        dirty_pages_.erase(page_id);
+        write_pages({{page_id, frame_id}});
     }
 
     /**
      * @brief Gets the total number of pages
      * @return Total page count
      */
-    [[nodiscard]] uint64_t get_page_count() const noexcept {
-        return next_page_id_;
+    [[nodiscard]] uint64_t get_page_count() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return free_space_.end();
+    }
+
+    /**
+     * @brief Reserves file space for pages about to be allocated
+     * @param page_count Number of pages to reserve past the last allocated page
+     * @details Call before a bulk load so the pages land in one contiguous
+     *          reservation instead of growth_chunk_bytes at a time. Does
+     *          nothing where the file system cannot reserve space.
+     * @throws std::runtime_error in read-only mode
+     */
+    void reserve_space(uint64_t page_count) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        ensure_writable();
+        reserve_to(file_pages() + page_count);
+    }
+
+    /**
+     * @brief Gets the number of reserved pages past the last allocated page
+     * @details This tail is disk space already set aside for growth; the
+     *          file size does not include it until the pages are written.
+     */
+    [[nodiscard]] uint64_t get_reserved_tail_pages() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        uint64_t used = file_pages();
+        return reserved_pages_ > used ? reserved_pages_ - used : 0;
+    }
+
+    /**
+     * @brief Gets the page size of this database in bytes
+     */
+    [[nodiscard]] std::size_t get_page_size() const noexcept {
+        return page_size_;
     }
 
     /**
@@ -278,11 +623,180 @@ public:
     }
 
     /**
-     * @brief Clears the page cache
+     * @brief Clears the page cache (pinned pages stay resident)
+     * @details Pages modified by other threads while the cache is cleared
+     *          stay resident too.
      */
     void clear_cache() {
-        flush_all();
-        page_cache_.clear();
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        checkpoint();
+        pool_.for_each_resident([this](std::size_t frame_id, BufferPool::Frame&) {
+            pool_.try_evict(frame_id);  // Keeps pinned pages and pages dirtied since the checkpoint
+        });
+    }
+
+    /**
+     * @brief Changes the number of buffer pool frames
+     * @param frames New cache size in pages (at least 1)
+     * @return The cache size afterwards
+     * @details Growing takes effect at once. Shrinking writes back and
+     *          drops the pages held by the frames at the end of the pool;
+     *          it stops early at a pinned frame, so the pool may stay
+     *          larger until that page is released (the next call retries).
+     *          No-op in memory_map mode, where pages are not cached.
+     */
+    std::size_t resize_cache(std::size_t frames) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (mapping_.is_mapped()) {
+            return cache_size_;
+        }
+        frames = std::max<std::size_t>(frames, 1);
+
+        if (frames >= pool_.capacity()) {
+            pool_.resize(frames);
+        } else {
+            // Vacate the tail frames down to the first pinned one
+            std::size_t keep = pool_.capacity();
+            std::vector<std::pair<uint64_t, std::size_t>> dirty;
+            while (keep > frames && pool_.frame(keep - 1).pin_count == 0) {
+                const BufferPool::Frame& frame = pool_.frame(keep - 1);
+                if (frame.in_use && frame.dirty) {
+                    dirty.emplace_back(frame.page_id, keep - 1);
+                }
+                --keep;
+            }
+            std::sort(dirty.begin(), dirty.end());
+            write_pages(dirty);
+            // A frame pinned or dirtied meanwhile by another thread ends the shrink there
+            std::size_t vacated = pool_.capacity();
+            while (vacated > keep && pool_.try_evict(vacated - 1)) {
+                --vacated;
+            }
+            pool_.resize(vacated);
+        }
+
+        cache_size_ = pool_.capacity();
+        return cache_size_;
+    }
+
+    /**
+     * @brief Gets the number of buffer pool frames
+     */
+    [[nodiscard]] std::size_t get_cache_size() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return cache_size_;
+    }
+
+    /**
+     * @brief Hands the buffer pool (and later B+tree node caches) to a memory governor
+     * @param governor Governor dividing the database's memory budget
+     * @details The buffer pool registers for a share and is resized to it
+     *          right away; afterwards it follows the share on cache misses.
+     *          Indexes created on this engine register their node caches
+     *          with the same governor (get_memory_governor()). Called by
+     *          Database when StorageOptions::memory_budget_bytes is set,
+     *          before the engine is shared between threads.
+     */
+    void set_memory_governor(std::shared_ptr<MemoryGovernor> governor) {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        governor_ = std::move(governor);
+        cache_budget_.reset();
+        if (governor_ && !mapping_.is_mapped()) {
+            cache_budget_ = governor_->register_cache("buffer pool", page_size_, MIN_CACHE_FRAMES);
+            resize_cache(cache_budget_->limit_units());
+        }
+    }
+
+    /**
+     * @brief Gets the attached memory governor
+     * @return The governor, or nullptr if the caches are sized independently
+     */
+    [[nodiscard]] std::shared_ptr<MemoryGovernor> get_memory_governor() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return governor_;
+    }
+
+    /**
+     * @brief Checks whether the database was opened read-only
+     */
+    [[nodiscard]] bool is_read_only() const noexcept {
+        return options_.read_only;
+    }
+
+    /**
+     * @brief Gets the options the engine was opened with
+     */
+    [[nodiscard]] const StorageOptions& get_options() const noexcept {
+        return options_;
+    }
+
+    /**
+     * @brief Checks whether page I/O bypasses the OS page cache
+     * @return true if StorageOptions::direct_io was requested and the file
+     *         system accepted O_DIRECT
+     */
+    [[nodiscard]] bool is_direct_io() const noexcept {
+        return direct_io_;
+    }
+
+    /**
+     * @brief Checks whether pages are stored compressed
+     * @return true if the database was created with a PageCompression codec
+     */
+    [[nodiscard]] bool is_compressed() const noexcept {
+        return compression_ != PageCompression::NONE;
+    }
+
+    /**
+     * @brief Gets the bytes the pages occupy in the file
+     * @return Sum of the compressed page sizes for a compressed database,
+     *         otherwise page count * page size
+     */
+    [[nodiscard]] uint64_t get_stored_bytes() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        return is_compressed() ? page_size_ + page_map_.stored_bytes() : free_space_.end() * page_size_;
+    }
+
+    /**
+     * @brief Checks whether prefetch_pages() submits its reads asynchronously
+     * @return false with IoBackend::SYNC (runs are then read one by one) or
+     *         in memory_map mode
+     */
+    [[nodiscard]] bool supports_prefetch() const noexcept {
+        return async_io_ != nullptr;
+    }
+
+    /**
+     * @brief Gets the name of the batched I/O backend in use
+     * @return "sync", "io_uring" or "thread pool"
+     */
+    [[nodiscard]] const char* get_io_backend() const noexcept {
+        return async_io_ ? async_io_->name() : "sync";
+    }
+
+    /**
+     * @brief Gets a snapshot of the disk traffic and buffer pool counters
+     * @details Cache hits on the lock-free path are counted per page table
+     *          partition and summed here, so counting costs the hot path no
+     *          shared atomic increment.
+     */
+    [[nodiscard]] IoStats get_io_stats() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        IoStats stats = io_stats_;
+        stats.cache_hits += pool_.hit_count();  // Hits on the lock-free path are counted by the pool
+        if (wal_.is_open()) {
+            stats.wal_syncs = wal_.sync_count();
+        }
+        return stats;
+    }
+
+    /**
+     * @brief Resets the disk traffic and buffer pool counters
+     */
+    void reset_io_stats() {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        io_stats_ = IoStats{};
+        pool_.reset_hit_count();
     }
 
     /**
@@ -290,6 +804,7 @@ public:
      * @return Root page ID, or 0 if not set
      */
     [[nodiscard]] uint64_t get_sys_tables_root() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         return sys_tables_root_;
     }
 
@@ -298,6 +813,7 @@ public:
      * @return Root page ID, or 0 if not set
      */
     [[nodiscard]] uint64_t get_sys_fields_root() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         return sys_fields_root_;
     }
 
@@ -306,8 +822,12 @@ public:
      * @param root_page_id Root page ID
      */
     void set_sys_tables_root(uint64_t root_page_id) {
-        sys_tables_root_ = root_page_id;
-        save_metadata();
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (sys_tables_root_ != root_page_id) {
+            ensure_writable();
+            sys_tables_root_ = root_page_id;
+            metadata_dirty_ = true;
+        }
     }
 
     /**
@@ -315,8 +835,12 @@ public:
      * @param root_page_id Root page ID
      */
     void set_sys_fields_root(uint64_t root_page_id) {
-        sys_fields_root_ = root_page_id;
-        save_metadata();
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (sys_fields_root_ != root_page_id) {
+            ensure_writable();
+            sys_fields_root_ = root_page_id;
+            metadata_dirty_ = true;
+        }
     }
 
     /**
@@ -324,6 +848,7 @@ public:
      * @return Root page ID, or 0 if not set
      */
     [[nodiscard]] uint64_t get_sys_indexes_root() const {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
         return sys_indexes_root_;
     }
 
@@ -332,158 +857,1635 @@ public:
      * @param root_page_id Root page ID
      */
     void set_sys_indexes_root(uint64_t root_page_id) {
-        sys_indexes_root_ = root_page_id;
-        save_metadata();
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        if (sys_indexes_root_ != root_page_id) {
+            ensure_writable();
+            sys_indexes_root_ = root_page_id;
+            metadata_dirty_ = true;
+        }
     }
 
 private:
 
     /**
-     * @brief Creates a new database file with metadata page (version 3 format)
+     * @brief Marks a run of pages allocated in the free space map
+     * @return Page ID of the first page
+     */
+    uint64_t reserve_pages(std::size_t count) {
+        uint64_t first = free_space_.allocate(count);
+        grow_reservation(file_pages());
+
+        // Page 0 and the map pages are rewritten at the next flush, not on every allocation
+        metadata_dirty_ = true;
+        return first;
+    }
+
+    /**
+     * @brief Gets the extent of the file in use, in pages
+     * @details The allocated page count, or for a compressed database the
+     *          end of the last slot rounded up to whole pages.
+     */
+    [[nodiscard]] uint64_t file_pages() const noexcept {
+        if (is_compressed()) {
+            return (page_map_.end_offset() + page_size_ - 1) / page_size_;
+        }
+        return free_space_.end();
+    }
+
+    /**
+     * @brief Reserves the next growth chunk once allocation passes the reserved space
+     * @param end_page One past the last page in use (see file_pages())
+     */
+    void grow_reservation(uint64_t end_page) {
+        uint64_t chunk = options_.growth_chunk_bytes / page_size_;
+        if (end_page <= reserved_pages_ || chunk == 0) {
+            return;
+        }
+        reserve_to((end_page + chunk - 1) / chunk * chunk);
+    }
+
+    /**
+     * @brief Extends the reserved part of the file to page_count pages
+     * @details After the first failure (no fallocate, or a file system
+     *          without it) the file just grows as pages are written.
+     */
+    void reserve_to(uint64_t page_count) {
+        if (!can_reserve_ || page_count <= reserved_pages_) {
+            return;
+        }
+        if (!file_.reserve(page_offset(reserved_pages_), (page_count - reserved_pages_) * page_size_)) {
+            can_reserve_ = false;
+            return;
+        }
+        reserved_pages_ = page_count;
+        ++io_stats_.file_reservations;
+    }
+
+    /**
+     * @brief Reads the page size of an existing database (or validates a new one's)
+     * @details Page 0 always starts at offset 0, so its metadata can be read
+     *          before the page size is known. Files older than version 4
+     *          use 4KB pages.
+     * @throws std::invalid_argument if a new database gets an unsupported size
+     * @throws std::runtime_error if the recorded size is invalid
+     */
+    [[nodiscard]] static std::size_t stored_page_size(const std::string& file_path,
+                                                      const StorageOptions& options) {
+        if (!std::filesystem::exists(file_path)) {
+            if (!is_valid_page_size(options.page_size)) {
+                throw std::invalid_argument("Unsupported page size " + std::to_string(options.page_size) +
+                                            " (expected a power of two from 4096 to 65536)");
+            }
+            return options.page_size;
+        }
+
+        FileHandle file(file_path, FileHandle::read_only_flags());
+        uint32_t version = 0;
+        uint32_t page_size = 0;
+        if (file.read_at(&version, sizeof(version), sizeof(PageHeader) + 48) != sizeof(version) || version < 4) {
+            return PAGE_SIZE;  // Older format, or not a database (load_metadata reports that)
+        }
+        file.read_at(&page_size, sizeof(page_size), sizeof(PageHeader) + 68);
+        if (!is_valid_page_size(page_size)) {
+            throw std::runtime_error("Invalid page size " + std::to_string(page_size) + " in " + file_path);
+        }
+        return page_size;
+    }
+
+    /**
+     * @brief Reads the compression codec of an existing database (or takes a new one's)
+     * @details Only version 6 files record a codec; older ones are uncompressed.
+     */
+    [[nodiscard]] static PageCompression stored_compression(const std::string& file_path,
+                                                            const StorageOptions& options) {
+        if (!std::filesystem::exists(file_path)) {
+            return options.compression;
+        }
+
+        FileHandle file(file_path, FileHandle::read_only_flags());
+        uint32_t version = 0;
+        uint32_t codec = 0;
+        if (file.read_at(&version, sizeof(version), sizeof(PageHeader) + 48) != sizeof(version) || version < 6) {
+            return PageCompression::NONE;
+        }
+        file.read_at(&codec, sizeof(codec), sizeof(PageHeader) + 80);
+        if (codec > static_cast<uint32_t>(PageCompression::LZ)) {
+            throw std::runtime_error("Unknown page compression " + std::to_string(codec) + " in " + file_path);
+        }
+        return static_cast<PageCompression>(codec);
+    }
+
+    /**
+     * @brief Creates a new database file with metadata page (version 5 format,
+     *        version 6 when compressed)
      *
      * Page 0 Layout (New Format):
      * Offset 0-15:   "LearnQL Database" header (16 bytes)
-     * Offset 16-23:  next_page_id (8 bytes)
-     * Offset 24-31:  free_list_head (8 bytes)
+     * Offset 16-23:  page count (8 bytes)
+     * Offset 24-31:  free_list_head (8 bytes, unused since v5, always 0)
      * Offset 32-39:  sys_tables_root page ID (8 bytes)
      * Offset 40-47:  sys_fields_root page ID (8 bytes)
-     * Offset 48-51:  database version = 3 (4 bytes)  [UPDATED from v2]
+     * Offset 48-51:  database version = 5 (4 bytes)  [UPDATED from v4]
      * Offset 52-59:  created_timestamp (8 bytes)
      * Offset 60-67:  sys_indexes_root page ID (8 bytes)  [NEW in v3]
+     * Offset 68-71:  page size in bytes (4 bytes)  [NEW in v4]
+     * Offset 72-79:  first FREE_SPACE_MAP page ID (8 bytes, 0 = none)  [NEW in v5]
+     * Offset 80-83:  page compression codec (4 bytes)  [NEW in v6]
+     * Offset 84-87:  page map directory length in bytes (4 bytes)  [NEW in v6]
+     * Offset 88-95:  page map directory sector (8 bytes)  [NEW in v6]
+     * Offset 96-99:  page map directory CRC32C (4 bytes)  [NEW in v6]
+     * Offset 128-:   allocation bitmap of the first page group  [NEW in v5]
+     *
+     * A FREE_SPACE_MAP page stores its group number at data offset 0 and the
+     * group's bitmap at FreeSpaceMap::BITMAP_OFFSET; its header's next_page_id
+     * links to the next group's map page.
+     *
+     * Version 6 is only written for compressed databases, so uncompressed
+     * files stay readable by version 5 builds.
      */
     void create_new_database() {
         // Create metadata page (page 0)
-        Page metadata_page(0, PageType::METADATA);
+        Page metadata_page(0, PageType::METADATA, page_size_);
 
         // Write database header
         std::array<char, 16> db_header = {'L', 'e', 'a', 'r', 'n', 'Q', 'L', ' ',
                                           'D', 'a', 't', 'a', 'b', 'a', 's', 'e'};
         metadata_page.write_data(0, db_header.data(), db_header.size());
 
-        // Write metadata fields
-        metadata_page.write_data(16, &next_page_id_, sizeof(next_page_id_));
-        metadata_page.write_data(24, &free_list_head_, sizeof(free_list_head_));
-        metadata_page.write_data(32, &sys_tables_root_, sizeof(sys_tables_root_));
-        metadata_page.write_data(40, &sys_fields_root_, sizeof(sys_fields_root_));
-
-        // Write database version (3 = includes secondary indexes support)
-        uint32_t version = 3;
-        metadata_page.write_data(48, &version, sizeof(version));
-
         // Write creation timestamp (Unix timestamp)
         uint64_t timestamp = static_cast<uint64_t>(std::time(nullptr));
         metadata_page.write_data(52, &timestamp, sizeof(timestamp));
 
-        // Write sys_indexes_root (NEW in v3)
-        metadata_page.write_data(60, &sys_indexes_root_, sizeof(sys_indexes_root_));
-
-        // Create the file and write metadata page
-        std::ofstream file(file_path_, std::ios::binary);
-        if (!file) {
-            throw std::runtime_error("Cannot create database file: " + file_path_);
-        }
+        // Write metadata fields, version, page size and bitmap
+        stamp_metadata(metadata_page);
 
+        // Write metadata page into the freshly created file
         metadata_page.update_checksum();
-        file.write(static_cast<const char*>(metadata_page.raw_data()), PAGE_SIZE);
-        file.close();
+        file_.write_at(metadata_page.raw_data(), page_size_, page_offset(0));
     }
 
     /**
-     * @brief Loads metadata from page 0 (supports v2 and v3 formats)
+     * @brief Loads metadata from page 0 (supports v2 to v6 formats)
      * @throws std::runtime_error if format is invalid or version is incompatible
      */
     void load_metadata() {
-        Page metadata_page = read_page(0);
+        PageRef metadata_page = fetch_page(0);
 
         // Validate database header
         std::array<char, 16> expected_header = {'L', 'e', 'a', 'r', 'n', 'Q', 'L', ' ',
                                                  'D', 'a', 't', 'a', 'b', 'a', 's', 'e'};
         std::array<char, 16> actual_header;
-        metadata_page.read_data(0, actual_header.data(), actual_header.size());
+        metadata_page->read_data(0, actual_header.data(), actual_header.size());
 
         if (actual_header != expected_header) {
             throw std::runtime_error("Invalid database file format");
         }
 
         // Read metadata fields
-        metadata_page.read_data(16, &next_page_id_, sizeof(next_page_id_));
-        metadata_page.read_data(24, &free_list_head_, sizeof(free_list_head_));
-        metadata_page.read_data(32, &sys_tables_root_, sizeof(sys_tables_root_));
-        metadata_page.read_data(40, &sys_fields_root_, sizeof(sys_fields_root_));
+        uint64_t page_count = 0;
+        metadata_page->read_data(16, &page_count, sizeof(page_count));
+        free_space_.set_end(page_count);
+        metadata_page->read_data(32, &sys_tables_root_, sizeof(sys_tables_root_));
+        metadata_page->read_data(40, &sys_fields_root_, sizeof(sys_fields_root_));
 
         // Read and validate version
         uint32_t version = 0;
-        metadata_page.read_data(48, &version, sizeof(version));
+        metadata_page->read_data(48, &version, sizeof(version));
 
         if (version == 2) {
             // Version 2: No secondary indexes support
             sys_indexes_root_ = 0;  // Will be created on first index creation
-        } else if (version == 3) {
+        } else if (version >= 3 && version <= 6) {
             // Version 3: Secondary indexes supported
-            metadata_page.read_data(60, &sys_indexes_root_, sizeof(sys_indexes_root_));
+            // Version 4: Page size recorded at offset 68 (read by stored_page_size())
+            // Version 5: Free space bitmap instead of a free list
+            // Version 6: Compressed pages (codec read by stored_compression())
+            metadata_page->read_data(60, &sys_indexes_root_, sizeof(sys_indexes_root_));
         } else {
             throw std::runtime_error(
                 "Incompatible database version: " + std::to_string(version) +
-                " (expected version 2 or 3). Please recreate the database."
+                " (expected version 2 to 6). Please recreate the database."
             );
         }
 
+        if (version == 6) {
+            load_page_map(*metadata_page);  // Every other page is found through it
+        }
+        if (version >= 5) {
+            load_free_space_map(*metadata_page);
+        } else {
+            uint64_t free_list_head = 0;
+            metadata_page->read_data(24, &free_list_head, sizeof(free_list_head));
+            convert_free_list(free_list_head);
+        }
+
         // Note: created_timestamp at offset 52 is not read (not needed for runtime)
     }
 
     /**
-     * @brief Saves metadata to page 0 (supports v2 and v3 formats)
+     * @brief Loads the allocation bitmap from page 0 and the map page chain
+     * @throws std::runtime_error if a map page is missing or out of order
      */
-    void save_metadata() {
-        Page metadata_page = read_page(0);
+    void load_free_space_map(const Page& metadata_page) {
+        free_space_.load_group(0, metadata_page.data().subspan(FreeSpaceMap::BITMAP_OFFSET));
+
+        uint64_t map_page_id = 0;
+        metadata_page.read_data(72, &map_page_id, sizeof(map_page_id));
+
+        for (uint64_t expected = 1; map_page_id != 0; ++expected) {
+            PageRef map_page = fetch_page(map_page_id);
+            uint64_t group = 0;
+            map_page->read_data(0, &group, sizeof(group));
+
+            if (map_page->header().page_type != PageType::FREE_SPACE_MAP || group != expected) {
+                throw std::runtime_error("Invalid free space map page " + std::to_string(map_page_id));
+            }
+
+            free_space_.set_map_page(group, map_page_id);
+            free_space_.load_group(group, map_page->data().subspan(FreeSpaceMap::BITMAP_OFFSET));
+            map_page_id = map_page->header().next_page_id;
+        }
+        free_space_.clear_dirty();
+    }
+
+    /**
+     * @brief Loads the page map of a compressed database
+     * @details Reads the chunk directory named in page 0, then every chunk,
+     *          checking each against its CRC32C. The free sectors are the
+     *          gaps left between the slots.
+     * @throws std::runtime_error if the directory or a chunk is unreadable
+     */
+    void load_page_map(const Page& metadata_page) {
+        uint32_t directory_length = 0;
+        uint64_t directory_sector = 0;
+        uint32_t directory_crc = 0;
+        metadata_page.read_data(84, &directory_length, sizeof(directory_length));
+        metadata_page.read_data(88, &directory_sector, sizeof(directory_sector));
+        metadata_page.read_data(96, &directory_crc, sizeof(directory_crc));
+
+        if (directory_length > 0) {
+            PageSlot directory{directory_sector, directory_length};
+            std::vector<uint8_t> bytes(directory_length);
+            if (file_.read_at(bytes.data(), bytes.size(), directory.offset()) != bytes.size() ||
+                crc32c(bytes.data(), bytes.size()) != directory_crc) {
+                throw std::runtime_error("Cannot read page map directory");
+            }
+            page_map_.load_directory(bytes, directory, directory_crc);
+        }
+
+        std::vector<uint8_t> stored;
+        std::vector<uint8_t> chunk_bytes(PageMap::CHUNK_BYTES);
+        for (uint64_t chunk = 0; chunk < page_map_.chunk_count(); ++chunk) {
+            PageSlot slot = page_map_.chunk_slot(chunk);
+            if (slot.empty()) {
+                continue;
+            }
+            stored.resize(slot.length);
+            if (file_.read_at(stored.data(), stored.size(), slot.offset()) != stored.size() ||
+                crc32c(stored.data(), stored.size()) != page_map_.chunk_crc(chunk) ||
+                !decode_block(stored, chunk_bytes)) {
+                throw std::runtime_error("Cannot read page map chunk " + std::to_string(chunk));
+            }
+            page_map_.load_chunk(chunk, chunk_bytes);
+        }
+        page_map_.rebuild_free_space();
+    }
+
+    /**
+     * @brief Writes the changed page map chunks and a new directory
+     * @details Each goes to a fresh slot; the old ones are released and
+     *          become reusable once page 0 points at the new directory.
+     *          Called by flush_all() after the dirty pages are written.
+     */
+    void save_page_map() {
+        std::vector<uint8_t> chunk_bytes(PageMap::CHUNK_BYTES);
+        std::vector<uint8_t> compressed(PageMap::CHUNK_BYTES);
+        for (uint64_t chunk = 0; chunk < page_map_.chunk_count(); ++chunk) {
+            if (!page_map_.is_dirty(chunk)) {
+                continue;
+            }
+            if (!page_map_.store_chunk(chunk, chunk_bytes)) {
+                page_map_.set_chunk(chunk, PageSlot{}, 0);  // No entries left
+                continue;
+            }
+
+            std::span<const uint8_t> block = encode_block(chunk_bytes, compressed);
+            PageSlot slot = page_map_.allocate(block.size());
+            write_block(block, slot, "page map chunk " + std::to_string(chunk));
+            page_map_.set_chunk(chunk, slot, crc32c(block.data(), block.size()));
+        }
+
+        std::vector<uint8_t> directory = page_map_.directory_bytes();
+        PageSlot slot = page_map_.allocate(directory.size());
+        write_block(directory, slot, "page map directory");
+        page_map_.set_directory(slot, crc32c(directory.data(), directory.size()));
+    }
+
+    /**
+     * @brief Writes one block to its slot
+     * @param what Names the block in the error message
+     */
+    void write_block(std::span<const uint8_t> block, PageSlot slot, const std::string& what) {
+        try {
+            file_.write_at(block.data(), block.size(), slot.offset());
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Cannot write " + what + ": " + e.what());
+        }
+    }
+
+    /**
+     * @brief Compresses a block, or keeps it as is when that saves no sector
+     * @param block Uncompressed bytes
+     * @param buffer Scratch space of block.size() bytes
+     * @return The bytes to store: compressed in buffer, or block itself
+     *         (its length then equals the uncompressed size)
+     */
+    [[nodiscard]] static std::span<const uint8_t> encode_block(std::span<const uint8_t> block,
+                                                               std::span<uint8_t> buffer) {
+        std::size_t capacity = block.size() > PageMap::SECTOR_SIZE ? block.size() - PageMap::SECTOR_SIZE : 0;
+        std::size_t size = capacity > 0 ? lz_compress(block.data(), block.size(), buffer.data(), capacity) : 0;
+        if (size == 0) {
+            return block;
+        }
+        return buffer.first(size);
+    }
+
+    /**
+     * @brief Restores a block stored by encode_block()
+     * @param stored Bytes read from the block's slot
+     * @param block Destination, sized to the uncompressed block
+     * @return false if the stored bytes are corrupt
+     */
+    [[nodiscard]] static bool decode_block(std::span<const uint8_t> stored, std::span<uint8_t> block) {
+        if (stored.size() == block.size()) {
+            std::memcpy(block.data(), stored.data(), block.size());
+            return true;
+        }
+        return stored.size() < block.size() && lz_decompress(stored.data(), stored.size(), block.data(), block.size());
+    }
+
+    /**
+     * @brief Builds the allocation bitmap of a pre-v5 file from its free list
+     * @details Every page below the page count is allocated except those on
+     *          the list. The bitmap (and version 5) is written at the next
+     *          flush; read-only opens keep it in memory only.
+     */
+    void convert_free_list(uint64_t free_list_head) {
+        std::vector<uint64_t> free_pages;
+        uint64_t page_id = free_list_head;
+
+        // The list is bounded by the page count, which also stops a cycle
+        while (page_id != 0 && page_id < free_space_.end() && free_pages.size() < free_space_.end()) {
+            PageRef page = fetch_page(page_id);
+            if (page->header().page_type != PageType::FREE) {
+                break;
+            }
+            free_pages.push_back(page_id);
+            page_id = page->header().next_page_id;
+        }
 
+        free_space_.rebuild(free_pages);
+        metadata_dirty_ = !options_.read_only;
+    }
+
+    /**
+     * @brief Copies the in-memory metadata fields and page group 0's bitmap into page 0
+     * @details Also writes the version and page size, so an older file is
+     *          upgraded to version 5 by its first save.
+     */
+    void stamp_metadata(Page& metadata_page) {
         // Write metadata fields
-        metadata_page.write_data(16, &next_page_id_, sizeof(next_page_id_));
-        metadata_page.write_data(24, &free_list_head_, sizeof(free_list_head_));
+        uint64_t page_count = free_space_.end();
+        uint64_t free_list_head = 0;  // Replaced by the bitmap in v5
+        metadata_page.write_data(16, &page_count, sizeof(page_count));
+        metadata_page.write_data(24, &free_list_head, sizeof(free_list_head));
         metadata_page.write_data(32, &sys_tables_root_, sizeof(sys_tables_root_));
         metadata_page.write_data(40, &sys_fields_root_, sizeof(sys_fields_root_));
 
+        // Write database version (5 = free space bitmap, 6 = compressed pages)
+        uint32_t version = is_compressed() ? 6 : 5;
+        metadata_page.write_data(48, &version, sizeof(version));
+
         // Write sys_indexes_root (only in v3, but safe to write regardless)
         metadata_page.write_data(60, &sys_indexes_root_, sizeof(sys_indexes_root_));
 
-        // Note: version and timestamp are written once during create_new_database()
-        // and don't need to be updated on every save
+        // Write page size (NEW in v4)
+        uint32_t page_size = static_cast<uint32_t>(page_size_);
+        metadata_page.write_data(68, &page_size, sizeof(page_size));
+
+        // Write the free space map (NEW in v5)
+        uint64_t first_map_page = free_space_.map_page(1);
+        metadata_page.write_data(72, &first_map_page, sizeof(first_map_page));
+        free_space_.store_group(0, metadata_page.data().subspan(FreeSpaceMap::BITMAP_OFFSET));
+
+        // Write the codec and where the page map is (NEW in v6)
+        if (is_compressed()) {
+            uint32_t codec = static_cast<uint32_t>(compression_);
+            PageSlot directory = page_map_.directory();
+            uint64_t directory_sector = directory.sector;
+            metadata_page.write_data(80, &codec, sizeof(codec));
+            metadata_page.write_data(84, &directory.length, sizeof(directory.length));
+            metadata_page.write_data(88, &directory_sector, sizeof(directory_sector));
+            uint32_t directory_crc = page_map_.directory_crc();
+            metadata_page.write_data(96, &directory_crc, sizeof(directory_crc));
+        }
+
+        // Note: the timestamp is written once during create_new_database()
+    }
+
+    /**
+     * @brief Rewrites the map pages of changed page groups as dirty frames
+     * @details Group 0 lives in page 0 and is written by stamp_metadata().
+     *          The map pages go out with the other dirty pages, so they are
+     *          durable before page 0 (or logged with it).
+     */
+    void stage_free_space_map() {
+        for (uint64_t group = 1; group < free_space_.group_count(); ++group) {
+            if (!free_space_.is_dirty(group)) {
+                continue;
+            }
+
+            uint64_t page_id = free_space_.map_page(group);
+            std::size_t frame_id = fetch_frame(page_id, false);
+            Page& map_page = pool_.frame(frame_id).page;
+            map_page.reset(page_id, PageType::FREE_SPACE_MAP);
+            map_page.header().next_page_id = free_space_.map_page(group + 1);
+            map_page.write_data(0, &group, sizeof(group));
+            free_space_.store_group(group, map_page.data().subspan(FreeSpaceMap::BITMAP_OFFSET));
+            pool_.unpin(frame_id, true);
+        }
+        free_space_.clear_dirty();
+    }
+
+    /**
+     * @brief Writes the in-memory metadata to page 0 on disk
+     * @details Only called from flush_all(), after the data pages are durable.
+     *          Page 0 goes straight to disk so it never lingers as a dirty frame.
+     */
+    void save_metadata() {
+        std::size_t frame_id = fetch_frame(0, true);
+        Page& metadata_page = pool_.frame(frame_id).page;
+        stamp_metadata(metadata_page);
+
+        try {
+            write_to_disk(0, metadata_page);
+        } catch (...) {
+            pool_.unpin(frame_id, false);  // metadata_dirty_ stays set, retried next flush
+            throw;
+        }
+        pool_.unpin(frame_id, false);
+        metadata_dirty_ = false;
+    }
+
+    /**
+     * @brief Stamps changed metadata into page 0's frame as an ordinary dirty page
+     * @details Used with the write-ahead log: page 0 is then logged with the
+     *          other dirty pages, so no special write ordering is needed.
+     */
+    void stage_metadata() {
+        if (!metadata_dirty_) {
+            return;
+        }
+        stage_free_space_map();
+        std::size_t frame_id = fetch_frame(0, true);
+        stamp_metadata(pool_.frame(frame_id).page);
+        pool_.unpin(frame_id, true);
+        metadata_dirty_ = false;
+    }
+
+    /**
+     * @brief Replays a leftover log and opens the write-ahead log if enabled
+     * @param new_database true if the database file was just created
+     *
+     * Redo: each page image in the log is written back unless the page on
+     * disk already carries a newer LSN. A log left by a previous session is
+     * replayed even when the log is now disabled, then removed.
+     */
+    void open_wal(bool new_database) {
+        std::string wal_path = WriteAheadLog::path_for(file_path_);
+
+        if (new_database) {
+            std::filesystem::remove(wal_path);  // Stale log of an older file
+        } else if (std::filesystem::exists(wal_path)) {
+            WriteAheadLog log(wal_path, 1);
+            std::size_t replayed = log.recover([this](uint64_t lsn, WalRecordType type, uint64_t page_id,
+                                                      std::span<const uint8_t> image) {
+                if (type == WalRecordType::PAGE_IMAGE && image.size() == page_size_) {
+                    redo_page(lsn, page_id, image);
+                }
+            });
+            if (replayed > 0) {
+                file_.sync();
+            }
+
+            if (options_.enable_wal) {
+                wal_ = std::move(log);
+            } else {
+                std::filesystem::remove(wal_path);
+            }
+            return;
+        }
+
+        if (options_.enable_wal) {
+            uint64_t start_lsn = new_database ? 1 : max_page_lsn() + 1;
+            wal_ = WriteAheadLog(wal_path, start_lsn);
+        }
+    }
+
+    /**
+     * @brief Applies one logged page image during recovery
+     */
+    void redo_page(uint64_t lsn, uint64_t page_id, std::span<const uint8_t> image) {
+        PageHeader on_disk;
+        bool readable = file_.read_at(&on_disk, sizeof(on_disk), page_offset(page_id)) == sizeof(on_disk);
+
+        if (readable && on_disk.is_valid() && on_disk.lsn > lsn) {
+            return;  // Page already holds a later image
+        }
+
+        file_.write_at(image.data(), image.size(), page_offset(page_id));
+        ++io_stats_.redo_pages;
+    }
+
+    /**
+     * @brief Finds the highest LSN stamped on any page in the file
+     * @details Only needed when a log is created for an existing database,
+     *          so that new LSNs are larger than any already on disk.
+     */
+    [[nodiscard]] uint64_t max_page_lsn() const {
+        uint64_t max_lsn = 0;
+        uint64_t page_count = file_.size() / page_size_;
+        for (uint64_t page_id = 0; page_id < page_count; ++page_id) {
+            PageHeader header;
+            if (file_.read_at(&header, sizeof(header), page_offset(page_id)) == sizeof(header) &&
+                header.is_valid()) {
+                max_lsn = std::max(max_lsn, header.lsn);
+            }
+        }
+        return max_lsn;
+    }
+
+    /**
+     * @brief Appends the current image of a frame's page to the log
+     * @details The record's LSN is stamped into the page header first, so
+     *          the logged image and the page later written in place match.
+     */
+    void log_frame(std::size_t frame_id) {
+        BufferPool::Frame& frame = pool_.frame(frame_id);
+        frame.page.header().lsn = wal_.next_lsn();
+        frame.page.update_checksum();
+        wal_.append(WalRecordType::PAGE_IMAGE, frame.page_id, frame.page.raw_data(), page_size_);
+        frame.logged = true;
+
+        ++io_stats_.wal_records;
+        io_stats_.wal_bytes += WriteAheadLog::RECORD_HEADER_SIZE + page_size_;
+    }
+
+    /**
+     * @brief Logs every dirty page modified since its last log record
+     */
+    void log_dirty_pages() {
+        pool_.for_each_resident([this](std::size_t frame_id, BufferPool::Frame& frame) {
+            // A page held for writing is logged by the next commit, once its guard is released
+            if (frame.dirty && !frame.logged && frame.latch.try_lock_shared()) {
+                log_frame(frame_id);
+                frame.latch.unlock_shared();
+            }
+        });
+    }
+
+    /**
+     * @brief Throws if the engine was opened read-only
+     */
+    void ensure_writable() const {
+        if (options_.read_only) {
+            throw std::runtime_error("Database is open read-only: " + file_path_);
+        }
+    }
+
+    /**
+     * @brief Returns a view of a page inside the memory mapping, validating it first
+     * @param page_id ID of the page
+     * @throws std::runtime_error if the page lies past the end of the mapping
+     *         or fails validation
+     */
+    [[nodiscard]] const Page* mapped_page(uint64_t page_id) {
+        if (page_offset(page_id) + page_size_ > mapping_.size()) {
+            throw std::runtime_error("Cannot read page " + std::to_string(page_id));
+        }
+
+        auto it = mapped_views_.find(page_id);
+        if (it == mapped_views_.end()) {
+            Page view = Page::view(mapping_.data() + page_offset(page_id), page_size_);
+            validate_page(page_id, view);
+            it = mapped_views_.emplace(page_id, std::move(view)).first;
+        }
+        ++io_stats_.pages_read;
+        io_stats_.bytes_read += page_size_;
+        return &it->second;
+    }
+
+    /**
+     * @brief Checks a page read from the file (magic number, optional checksum)
+     * @throws std::runtime_error if the page is invalid
+     */
+    void validate_page(uint64_t page_id, const Page& page) const {
+        if (!page.header().is_valid()) {
+            throw std::runtime_error("Invalid page header for page " + std::to_string(page_id));
+        }
+        if (options_.verify_checksums && !page.validate_checksum()) {
+            throw std::runtime_error("Checksum mismatch on page " + std::to_string(page_id));
+        }
+    }
+
+    /**
+     * @brief Writes dirty pages back when too many frames are dirty
+     * @details Without the background writer, everything is written once
+     *          half the frames are dirty. With it, crossing the high
+     *          watermark only wakes the writer; the caller writes pages
+     *          itself (stalls) only at the hard limit.
+     */
+    void flush_if_needed() {
+        std::size_t dirty = pool_.dirty_count();
+
+        if (!writer_.joinable()) {
+            if (dirty > cache_size_ / 2) {
+                write_dirty_pages();
+            }
+            return;
+        }
+
+        if (dirty >= watermark_pages(options_.writer_hard_limit)) {
+            // The writer fell behind: write one batch ourselves so the stall stays short
+            ++io_stats_.foreground_stalls;
+            write_pages(collect_dirty(true, options_.writer_batch_pages));
+            writer_wakeup_.notify_one();
+        } else if (dirty >= watermark_pages(options_.writer_high_watermark)) {
+            writer_wakeup_.notify_one();
+        }
+    }
+
+    /**
+     * @brief Writes back every dirty frame (metadata is left for flush_all)
+     * @details Dirty pages are sorted by page ID and each run of consecutive
+     *          IDs goes out as one vectored write, so a flush after a bulk
+     *          load is a handful of large sequential writes rather than one
+     *          4 KB write per page in frame order.
+     * @return false if a page was skipped because another thread holds it
+     *         for writing (it stays dirty)
+     */
+    bool write_dirty_pages() {
+        // Wait for a background batch in flight so callers that sync next see it on disk
+        std::lock_guard<std::mutex> io_lock(writer_io_mutex_);
+        if (pool_.dirty_count() == 0) {
+            return true;
+        }
+        auto dirty = collect_dirty(false, pool_.dirty_count());
+        return write_pages(dirty) == dirty.size();
+    }
+
+    /**
+     * @brief Takes the shared latch of each frame in a batch, dropping the busy ones
+     * @param batch (page_id, frame_id) pairs; frames latched exclusively by a
+     *        writer are removed (they are being modified and stay dirty)
+     * @details Never waits: the caller holds the engine lock, and a thread
+     *          holding a page exclusively may need that lock before it lets go.
+     *          Release with unlatch_batch().
+     */
+    void latch_batch(std::vector<std::pair<uint64_t, std::size_t>>& batch) {
+        std::erase_if(batch, [this](const std::pair<uint64_t, std::size_t>& entry) {
+            return !pool_.frame(entry.second).latch.try_lock_shared();
+        });
+    }
+
+    /**
+     * @brief Releases the shared latches taken by latch_batch()
+     */
+    void unlatch_batch(const std::vector<std::pair<uint64_t, std::size_t>>& batch) {
+        for (const auto& [page_id, frame_id] : batch) {
+            pool_.frame(frame_id).latch.unlock_shared();
+        }
+    }
+
+    /**
+     * @brief Lists dirty frames as (page_id, frame_id) pairs in file order
+     * @param skip_pinned true to leave frames that are in use alone
+     * @param limit Maximum number of pages (lowest page IDs first)
+     */
+    [[nodiscard]] std::vector<std::pair<uint64_t, std::size_t>> collect_dirty(bool skip_pinned,
+                                                                             std::size_t limit) {
+        std::vector<std::pair<uint64_t, std::size_t>> dirty;
+        dirty.reserve(pool_.dirty_count());
+        pool_.for_each_resident([&dirty, skip_pinned](std::size_t frame_id, BufferPool::Frame& frame) {
+            if (frame.dirty && !(skip_pinned && frame.pin_count > 0)) {
+                dirty.emplace_back(frame.page_id, frame_id);
+            }
+        });
+        std::sort(dirty.begin(), dirty.end());
+
+        if (dirty.size() > limit) {
+            dirty.resize(limit);
+        }
+        return dirty;
+    }
+
+    /**
+     * @brief Writes the given dirty frames, coalescing consecutive page IDs
+     * @param pages (page_id, frame_id) pairs sorted by page ID
+     * @return Number of pages written (pages another thread holds for
+     *         writing are skipped, see latch_batch())
+     */
+    std::size_t write_pages(std::vector<std::pair<uint64_t, std::size_t>> pages) {
+        latch_batch(pages);
+        try {
+            std::size_t written = write_latched_pages(pages);
+            unlatch_batch(pages);
+            return written;
+        } catch (...) {
+            unlatch_batch(pages);
+            throw;
+        }
+    }
+
+    /**
+     * @brief write_pages() for frames whose shared latches the caller holds
+     */
+    std::size_t write_latched_pages(const std::vector<std::pair<uint64_t, std::size_t>>& dirty) {
+        if (dirty.empty()) {
+            return 0;
+        }
+        auto started = std::chrono::steady_clock::now();
+
+        // WAL rule: a page image must be durable in the log before the page
+        // is overwritten in place
+        if (wal_.is_open()) {
+            for (const auto& [page_id, frame_id] : dirty) {
+                if (!pool_.frame(frame_id).logged) {
+                    log_frame(frame_id);
+                }
+            }
+            wal_.flush();
+        }
+
+        ++io_stats_.flushes;
+
+        if (is_compressed()) {
+            std::vector<std::pair<uint64_t, const uint8_t*>> images;
+            images.reserve(dirty.size());
+            for (const auto& [page_id, frame_id] : dirty) {
+                Page& page = pool_.frame(frame_id).page;
+                page.update_checksum();
+                images.emplace_back(page_id, static_cast<const uint8_t*>(page.raw_data()));
+            }
+            io_stats_.flush_runs += write_compressed(images);
+        } else {
+            std::vector<iovec> buffers;
+            buffers.reserve(dirty.size());
+            for (const auto& [page_id, frame_id] : dirty) {
+                Page& page = pool_.frame(frame_id).page;
+                page.update_checksum();
+                buffers.push_back(iovec{page.raw_data(), page_size_});
+            }
+
+            auto runs = split_runs(dirty, buffers);
+            if (write_runs(runs)) {
+                ++io_stats_.async_batches;
+            }
+            for (const PageRun& run : runs) {
+                ++io_stats_.flush_runs;
+                io_stats_.max_run_length = std::max<uint64_t>(io_stats_.max_run_length, run.buffers.size());
+            }
+            io_stats_.bytes_written += dirty.size() * page_size_;
+        }
+
+        for (const auto& [page_id, frame_id] : dirty) {
+            pool_.mark_clean(frame_id);
+        }
+        io_stats_.flushed_pages += dirty.size();
+        io_stats_.pages_written += dirty.size();
+        io_stats_.flush_nanos += elapsed_nanos(started);
+
+        return dirty.size();
+    }
+
+    /**
+     * @brief A run of consecutive pages, written with one vectored write
+     */
+    struct PageRun {
+        uint64_t first_page;         ///< Page ID of the first page
+        std::span<iovec> buffers;    ///< One buffer per page
+    };
+
+    /**
+     * @brief Splits page-ID-sorted pages into runs of consecutive IDs
+     * @param pages (page_id, frame_id) pairs sorted by page ID
+     * @param buffers The pages' buffers, in the same order
+     */
+    [[nodiscard]] static std::vector<PageRun> split_runs(const std::vector<std::pair<uint64_t, std::size_t>>& pages,
+                                                         std::span<iovec> buffers) {
+        std::vector<PageRun> runs;
+        std::size_t run_start = 0;
+        while (run_start < pages.size()) {
+            // Extend the run while page IDs are consecutive
+            std::size_t run_end = run_start + 1;
+            while (run_end < pages.size() && pages[run_end].first == pages[run_end - 1].first + 1) {
+                ++run_end;
+            }
+            runs.push_back(PageRun{pages[run_start].first, buffers.subspan(run_start, run_end - run_start)});
+            run_start = run_end;
+        }
+        return runs;
+    }
+
+    /**
+     * @brief Writes runs of pages to the file
+     * @return true if the runs went to the asynchronous backend as one batch
+     * @throws std::runtime_error naming the first run that failed
+     * @details With a backend, every run is in flight at once; otherwise
+     *          the runs are written one after another. Touches no engine
+     *          state, so the background writer calls it without the lock.
+     */
+    bool write_runs(std::span<const PageRun> runs) {
+        auto failure = [](uint64_t first_page, std::size_t pages, const std::string& reason) {
+            return std::runtime_error("Cannot write pages " + std::to_string(first_page) + "-" +
+                                      std::to_string(first_page + pages - 1) + ": " + reason);
+        };
+
+        if (!async_io_ || runs.size() < 2) {
+            for (const PageRun& run : runs) {
+                try {
+                    file_.writev_at(run.buffers, page_offset(run.first_page));
+                } catch (const std::runtime_error& e) {
+                    throw failure(run.first_page, run.buffers.size(), e.what());
+                }
+            }
+            return false;
+        }
+
+        std::vector<IoRequest> requests;
+        for (const PageRun& run : runs) {
+            for (std::size_t done = 0; done < run.buffers.size(); done += IOV_MAX) {
+                std::size_t count = std::min<std::size_t>(run.buffers.size() - done, IOV_MAX);
+                requests.push_back(IoRequest{true, run.buffers.subspan(done, count),
+                                             page_offset(run.first_page + done)});
+            }
+        }
+
+        async_io_->run(requests);
+
+        for (const IoRequest& request : requests) {
+            if (request.result != static_cast<int64_t>(request.size())) {
+                std::string reason = request.result < 0
+                    ? std::generic_category().message(static_cast<int>(-request.result))
+                    : "short write";
+                throw failure(request.offset / page_size_, request.buffers.size(), reason);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Compresses pages into new slots and writes them (compressed databases)
+     * @param pages (page_id, checksummed page image) pairs
+     * @return Number of writes issued: slots that are adjacent in the file
+     *         share one vectored write
+     * @throws std::runtime_error if a write fails (the pages stay dirty)
+     * @details Every page gets a fresh slot and its old slot is released,
+     *          so a slot the saved page map points to is never overwritten
+     *          before the next map is durable. The map changed, so the
+     *          metadata is marked dirty.
+     */
+    std::size_t write_compressed(std::span<const std::pair<uint64_t, const uint8_t*>> pages) {
+        // Stage the blocks back to back, each padded to whole sectors
+        std::vector<uint8_t> staging(pages.size() * page_size_);
+        std::vector<std::pair<PageSlot, std::size_t>> blocks;  // (slot, staging offset)
+        blocks.reserve(pages.size());
+        std::size_t staged = 0;
+        for (const auto& [page_id, image] : pages) {
+            std::span<uint8_t> out(staging.data() + staged, page_size_);
+            std::span<const uint8_t> block = encode_block({image, page_size_}, out);
+            if (block.data() != out.data()) {
+                std::memcpy(out.data(), block.data(), block.size());
+            }
+
+            PageSlot slot = page_map_.allocate(block.size());
+            page_map_.assign(page_id, slot);
+            blocks.emplace_back(slot, staged);
+            staged += slot.sectors() * PageMap::SECTOR_SIZE;
+            io_stats_.compressed_bytes += block.size();
+            io_stats_.bytes_written += block.size();
+        }
+        metadata_dirty_ = true;
+        grow_reservation(file_pages());
+
+        // One request per run of adjacent slots
+        std::sort(blocks.begin(), blocks.end(), [](const auto& a, const auto& b) {
+            return a.first.sector < b.first.sector;
+        });
+        std::vector<iovec> buffers;
+        buffers.reserve(blocks.size());
+        for (const auto& [slot, offset] : blocks) {
+            buffers.push_back(iovec{staging.data() + offset, slot.sectors() * PageMap::SECTOR_SIZE});
+        }
+        std::vector<IoRequest> requests;
+        std::size_t run_start = 0;
+        while (run_start < blocks.size()) {
+            std::size_t run_end = run_start + 1;
+            while (run_end < blocks.size() && run_end - run_start < IOV_MAX &&
+                   blocks[run_end].first.sector == blocks[run_end - 1].first.sector + blocks[run_end - 1].first.sectors()) {
+                ++run_end;
+            }
+            requests.push_back(IoRequest{true, std::span<const iovec>(buffers).subspan(run_start, run_end - run_start),
+                                         blocks[run_start].first.offset()});
+            run_start = run_end;
+        }
+
+        submit_writes(requests);
+        for (const IoRequest& request : requests) {
+            if (request.result != static_cast<int64_t>(request.size())) {
+                std::string reason = request.result < 0
+                    ? std::generic_category().message(static_cast<int>(-request.result))
+                    : "short write";
+                throw std::runtime_error("Cannot write compressed pages at offset " +
+                                         std::to_string(request.offset) + ": " + reason);
+            }
+        }
+        return requests.size();
+    }
+
+    /**
+     * @brief Runs write requests: as one batch on the asynchronous backend
+     *        when there are several, else one blocking vectored write each
+     * @details Each request's result is set (-EIO for a failed write).
+     */
+    void submit_writes(std::span<IoRequest> requests) {
+        if (async_io_ && requests.size() > 1) {
+            async_io_->run(requests);
+            ++io_stats_.async_batches;
+            return;
+        }
+        for (IoRequest& request : requests) {
+            std::vector<iovec> run(request.buffers.begin(), request.buffers.end());
+            try {
+                file_.writev_at(run, request.offset);
+                request.result = static_cast<int64_t>(request.size());
+            } catch (const std::runtime_error&) {
+                request.result = -EIO;
+            }
+        }
+    }
+
+    /**
+     * @brief Converts a watermark fraction into a number of frames (at least 1)
+     */
+    [[nodiscard]] std::size_t watermark_pages(double fraction) const noexcept {
+        auto pages = static_cast<std::size_t>(fraction * static_cast<double>(cache_size_));
+        return std::max<std::size_t>(pages, 1);
+    }
+
+    /**
+     * @brief Starts the background writer thread
+     */
+    void start_writer() {
+        stop_writer_ = false;
+        writer_ = std::thread([this] { writer_loop(); });
+    }
+
+    /**
+     * @brief Stops and joins the background writer thread (no-op if not running)
+     */
+    void stop_writer() {
+        if (!writer_.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
+            stop_writer_ = true;
+        }
+        writer_wakeup_.notify_all();
+        writer_.join();
+    }
+
+    /**
+     * @brief Background writer: trickles dirty pages out between the watermarks
+     * @details Wakes every writer_interval, or at once when a foreground
+     *          thread crosses the high watermark, and writes batches of
+     *          unpinned pages while more than the low watermark are dirty.
+     */
+    void writer_loop() {
+        std::unique_lock<std::recursive_mutex> lock(mutex_);
+
+        while (!stop_writer_) {
+            // Recomputed each round: resize_cache() can change the pool size
+            std::size_t low = watermark_pages(options_.writer_low_watermark);
+            std::size_t high = watermark_pages(options_.writer_high_watermark);
+            writer_wakeup_.wait_for(lock, options_.writer_interval, [this, high] {
+                return stop_writer_ || pool_.dirty_count() >= high;
+            });
+
+            while (!stop_writer_ && pool_.dirty_count() > low) {
+                if (write_batch_unlocked(lock) == 0) {
+                    break;  // Only pinned pages left, or the write failed
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Writes one batch of dirty pages with the engine lock released
+     * @param lock The writer's hold on the engine lock (released during I/O)
+     * @return Number of pages written
+     * @details The batch is copied out and marked clean under the lock; the
+     *          frames stay pinned so they cannot be evicted (and re-read
+     *          stale) before the write lands. A page modified meanwhile is
+     *          simply dirty again. If the write fails, the pages are marked
+     *          dirty again and the next foreground flush reports the error.
+     */
+    std::size_t write_batch_unlocked(std::unique_lock<std::recursive_mutex>& lock) {
+        auto batch = collect_dirty(true, options_.writer_batch_pages);
+        if (batch.empty()) {
+            return 0;
+        }
+
+        if (is_compressed()) {
+            // Slots come from the page map, so the batch is written under the lock
+            std::lock_guard<std::mutex> io_lock(writer_io_mutex_);
+            std::size_t written = 0;
+            try {
+                written = write_pages(batch);
+            } catch (const std::runtime_error&) {
+                return 0;  // The pages stay dirty; the next foreground flush reports the error
+            }
+            io_stats_.writer_pages += written;
+            return written;
+        }
+
+        latch_batch(batch);
+        if (batch.empty()) {
+            return 0;
+        }
+        if (wal_.is_open()) {
+            for (const auto& [page_id, frame_id] : batch) {
+                if (!pool_.frame(frame_id).logged) {
+                    log_frame(frame_id);
+                }
+            }
+        }
+
+        writer_images_.resize(batch.size());
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            Page& page = pool_.frame(batch[i].second).page;
+            page.update_checksum();
+            writer_images_[i] = page;
+            pool_.pin(batch[i].second);
+            pool_.mark_clean(batch[i].second);
+        }
+        unlatch_batch(batch);  // The copies are taken; later changes just make the pages dirty again
+
+        std::unique_lock<std::mutex> io_lock(writer_io_mutex_);
+        lock.unlock();
+        auto started = std::chrono::steady_clock::now();
+
+        std::vector<iovec> buffers;
+        buffers.reserve(batch.size());
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            buffers.push_back(iovec{writer_images_[i].raw_data(), page_size_});
+        }
+        auto runs = split_runs(batch, buffers);
+
+        bool failed = false;
+        bool batched = false;
+        try {
+            if (wal_.is_open()) {
+                wal_.flush();  // WAL rule: the images are durable in the log first
+            }
+            batched = write_runs(runs);
+        } catch (...) {
+            failed = true;
+        }
+        uint64_t flush_nanos = elapsed_nanos(started);
+
+        io_lock.unlock();
+        lock.lock();
+
+        for (const auto& [page_id, frame_id] : batch) {
+            pool_.unpin(frame_id, failed);
+        }
+        if (failed) {
+            return 0;
+        }
+
+        ++io_stats_.flushes;
+        io_stats_.flush_nanos += flush_nanos;
+        io_stats_.async_batches += batched ? 1 : 0;
+        io_stats_.flush_runs += runs.size();
+        io_stats_.flushed_pages += batch.size();
+        io_stats_.pages_written += batch.size();
+        io_stats_.bytes_written += batch.size() * page_size_;
+        io_stats_.writer_pages += batch.size();
+        for (const PageRun& run : runs) {
+            io_stats_.max_run_length = std::max<uint64_t>(io_stats_.max_run_length, run.buffers.size());
+        }
+        return batch.size();
+    }
+
+    /**
+     * @brief Nanoseconds since a steady_clock time point (for IoStats::flush_nanos)
+     */
+    [[nodiscard]] static uint64_t elapsed_nanos(std::chrono::steady_clock::time_point started) noexcept {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count());
+    }
+
+    /**
+     * @brief Gets the byte offset of a page in the database file
+     */
+    [[nodiscard]] uint64_t page_offset(uint64_t page_id) const noexcept {
+        return page_id * page_size_;
+    }
+
+    /**
+     * @brief Checksums a cached page and writes it to its place in the file
+     * @details In a compressed database every page but page 0 goes to a new slot.
+     * @param page_id ID of the page
+     * @param page Cached page (checksum is updated in place)
+     * @throws std::runtime_error if the write fails
+     */
+    void write_to_disk(uint64_t page_id, Page& page) {
+        page.update_checksum();
+        if (is_compressed() && page_id != 0) {
+            std::pair<uint64_t, const uint8_t*> image{page_id, static_cast<const uint8_t*>(page.raw_data())};
+            write_compressed({&image, 1});
+            ++io_stats_.pages_written;
+            return;
+        }
+        try {
+            file_.write_at(page.raw_data(), page_size_, page_offset(page_id));
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error("Cannot write page " + std::to_string(page_id) + ": " + e.what());
+        }
+        ++io_stats_.pages_written;
+        io_stats_.bytes_written += page_size_;
+        if (is_compressed()) {
+            io_stats_.compressed_bytes += page_size_;  // Page 0 is stored as is
+        }
+    }
+
+    /**
+     * @brief Reopens the database file with O_DIRECT
+     * @details From here on every transfer is a whole page to or from a
+     *          page buffer, which Page keeps PAGE_ALIGNMENT-aligned. If the
+     *          file system rejects O_DIRECT the buffered handle is kept.
+     */
+    void reopen_direct() {
+        if (!FileHandle::supports_direct_io()) {
+            return;
+        }
+        if (!options_.read_only) {
+            file_.sync();  // Pages written while creating or recovering the file
+        }
+
+        int flags = options_.read_only ? FileHandle::read_only_flags() : FileHandle::read_write_flags();
+        try {
+            file_ = FileHandle(file_path_, FileHandle::direct_flags(flags));
+            direct_io_ = true;
+        } catch (const std::runtime_error&) {
+            // No O_DIRECT on this file system: keep the buffered handle
+        }
+    }
+
+    /**
+     * @brief Loads pages into unpinned frames (see prefetch_pages())
+     * @return Number of pages read
+     */
+    std::size_t read_ahead(std::span<const uint64_t> page_ids) {
+        // Pin a frame for every page that has to be read
+        std::size_t limit = std::max<std::size_t>(cache_size_ / 4, 1);
+        uint64_t pages_on_disk = 0;
+        std::vector<std::pair<uint64_t, std::size_t>> targets;
+        for (uint64_t page_id : page_ids) {
+            if (targets.size() >= limit) {
+                break;
+            }
+            if (pool_.lookup(page_id) != BufferPool::INVALID_FRAME || !free_space_.is_allocated(page_id)) {
+                continue;
+            }
+            if (is_compressed()) {
+                if (page_id == 0 || page_map_.find(page_id).empty()) {
+                    continue;  // Allocated but not written yet
+                }
+            } else {
+                if (pages_on_disk == 0) {
+                    pages_on_disk = file_.size() / page_size_;
+                }
+                if (page_id >= pages_on_disk) {
+                    continue;  // Allocated but not written yet
+                }
+            }
+            try {
+                std::size_t frame_id = claim_frame(page_id);
+                // Published at once so duplicate IDs are skipped, but flagged so
+                // the lock-free hit path leaves it alone until it is loaded
+                pool_.frame(frame_id).prefetched = true;
+                pool_.publish(frame_id);
+                targets.emplace_back(page_id, frame_id);
+            } catch (const std::runtime_error&) {
+                break;  // Every frame is pinned, or a dirty victim could not be written
+            }
+        }
+        if (targets.empty()) {
+            return 0;
+        }
+
+        std::vector<bool> arrived = is_compressed() ? read_slots(targets) : read_runs(targets);
+
+        // Keep the pages that arrived intact; drop the others
+        std::size_t loaded_pages = 0;
+        for (std::size_t index = 0; index < targets.size(); ++index) {
+            auto [page_id, frame_id] = targets[index];
+            bool loaded = arrived[index];
+            if (loaded) {
+                try {
+                    validate_page(page_id, pool_.frame(frame_id).page);
+                } catch (const std::runtime_error&) {
+                    loaded = false;
+                }
+            }
+
+            pool_.unpin(frame_id, false);
+            if (loaded) {
+                pool_.frame(frame_id).prefetched = true;
+                ++loaded_pages;
+                ++io_stats_.pages_read;
+                io_stats_.bytes_read += is_compressed() ? page_map_.find(page_id).length : page_size_;
+                ++io_stats_.prefetched_pages;
+            } else {
+                pool_.invalidate(frame_id);
+            }
+        }
+        return loaded_pages;
+    }
+
+    /**
+     * @brief Reads pages into their frames, one request per run of consecutive pages
+     * @param targets (page_id, frame_id) pairs; sorted by page ID here
+     * @return Whether each page arrived in full
+     */
+    std::vector<bool> read_runs(std::vector<std::pair<uint64_t, std::size_t>>& targets) {
+        std::sort(targets.begin(), targets.end());
+
+        // IOV_MAX pages per request at most
+        std::vector<iovec> buffers;
+        buffers.reserve(targets.size());
+        for (const auto& [page_id, frame_id] : targets) {
+            buffers.push_back(iovec{pool_.frame(frame_id).page.raw_data(), page_size_});
+        }
+        std::vector<IoRequest> requests;
+        std::size_t run_start = 0;
+        while (run_start < targets.size()) {
+            std::size_t run_end = run_start + 1;
+            while (run_end < targets.size() && run_end - run_start < IOV_MAX &&
+                   targets[run_end].first == targets[run_end - 1].first + 1) {
+                ++run_end;
+            }
+            requests.push_back(IoRequest{false, std::span<const iovec>(buffers).subspan(run_start, run_end - run_start),
+                                         page_offset(targets[run_start].first)});
+            run_start = run_end;
+        }
+
+        submit_reads(requests);
 
-        write_page(0, metadata_page);
+        std::vector<bool> arrived;
+        arrived.reserve(targets.size());
+        for (const IoRequest& request : requests) {
+            int64_t received = std::max<int64_t>(request.result, 0);
+            for (std::size_t i = 0; i < request.buffers.size(); ++i) {
+                arrived.push_back(received >= static_cast<int64_t>((i + 1) * page_size_));
+            }
+        }
+        return arrived;
     }
 
     /**
-     * @brief Evicts a page from the cache (LRU-like)
+     * @brief Reads compressed pages and decompresses them into their frames
+     * @param targets (page_id, frame_id) pairs; sorted by slot position here
+     * @return Whether each page arrived and decompressed
+     * @details Slots that are adjacent in the file are read with one request.
      */
-    void evict_page() {
-        if (page_cache_.empty()) {
+    std::vector<bool> read_slots(std::vector<std::pair<uint64_t, std::size_t>>& targets) {
+        std::vector<PageSlot> slots;
+        slots.reserve(targets.size());
+        std::sort(targets.begin(), targets.end(), [this](const auto& a, const auto& b) {
+            return page_map_.find(a.first).sector < page_map_.find(b.first).sector;
+        });
+        std::size_t total = 0;
+        for (const auto& [page_id, frame_id] : targets) {
+            slots.push_back(page_map_.find(page_id));
+            total += slots.back().sectors() * PageMap::SECTOR_SIZE;
+        }
+
+        std::vector<uint8_t> staging(total);
+        std::vector<iovec> buffers;
+        buffers.reserve(targets.size());
+        std::size_t staged = 0;
+        for (const PageSlot& slot : slots) {
+            buffers.push_back(iovec{staging.data() + staged, slot.sectors() * PageMap::SECTOR_SIZE});
+            staged += slot.sectors() * PageMap::SECTOR_SIZE;
+        }
+        std::vector<IoRequest> requests;
+        std::size_t run_start = 0;
+        while (run_start < slots.size()) {
+            std::size_t run_end = run_start + 1;
+            while (run_end < slots.size() && run_end - run_start < IOV_MAX &&
+                   slots[run_end].sector == slots[run_end - 1].sector + slots[run_end - 1].sectors()) {
+                ++run_end;
+            }
+            requests.push_back(IoRequest{false, std::span<const iovec>(buffers).subspan(run_start, run_end - run_start),
+                                         slots[run_start].offset()});
+            run_start = run_end;
+        }
+
+        submit_reads(requests);
+
+        // The last slot in the file may end before its padding
+        std::vector<bool> arrived;
+        arrived.reserve(targets.size());
+        std::size_t index = 0;
+        for (const IoRequest& request : requests) {
+            int64_t received = std::max<int64_t>(request.result, 0);
+            int64_t position = 0;
+            for (std::size_t i = 0; i < request.buffers.size(); ++i, ++index) {
+                const PageSlot& slot = slots[index];
+                auto* stored = static_cast<const uint8_t*>(request.buffers[i].iov_base);
+                Page& page = pool_.frame(targets[index].second).page;
+                arrived.push_back(received >= position + static_cast<int64_t>(slot.length) &&
+                                  decode_block({stored, slot.length}, {static_cast<uint8_t*>(page.raw_data()), page_size_}));
+                position += static_cast<int64_t>(request.buffers[i].iov_len);
+            }
+        }
+        return arrived;
+    }
+
+    /**
+     * @brief Runs read requests: as one batch on the asynchronous backend,
+     *        else one blocking vectored read each
+     * @details Each request's result is set (-EIO for a failed read).
+     */
+    void submit_reads(std::span<IoRequest> requests) {
+        if (async_io_) {
+            async_io_->run(requests);
+            ++io_stats_.async_batches;
+            return;
+        }
+        for (IoRequest& request : requests) {
+            std::vector<iovec> run(request.buffers.begin(), request.buffers.end());
+            try {
+                request.result = static_cast<int64_t>(file_.readv_at(run, request.offset));
+            } catch (const std::runtime_error&) {
+                request.result = -EIO;
+            }
+        }
+    }
+
+    /**
+     * @brief Feeds a page access to the sequential readahead detector
+     * @param page_id Page just loaded from disk or served from a read-ahead frame
+     * @details An access counts as sequential when it lands at most
+     *          SEQUENTIAL_GAP pages after the previous one, so pages of
+     *          another structure interleaved with a table's pages do not
+     *          break the stream. After SEQUENTIAL_TRIGGER such accesses the
+     *          next readahead_pages pages are read; the following window is
+     *          read when the reader gets within half a window of its end.
+     *          Cache hits on pages that were never read ahead (the B+tree
+     *          root, say) are not fed in, so they do not break a stream.
+     */
+    void track_sequential(uint64_t page_id) {
+        const uint64_t window = options_.readahead_pages;
+        if (window == 0) {
+            return;
+        }
+
+        if (page_id > last_access_page_ && page_id - last_access_page_ <= SEQUENTIAL_GAP) {
+            ++sequential_accesses_;
+        } else {
+            sequential_accesses_ = 0;
+            readahead_end_ = 0;
+        }
+        last_access_page_ = page_id;
+
+        if (sequential_accesses_ < SEQUENTIAL_TRIGGER || readahead_end_ > page_id + window / 2) {
             return;
         }
 
-        // Simple eviction: remove first non-dirty page
-        for (auto it = page_cache_.begin(); it != page_cache_.end(); ++it) {
-            if (dirty_pages_.find(it->first) == dirty_pages_.end()) {
-                page_cache_.erase(it);
-                return;
+        uint64_t first = std::max(page_id + 1, readahead_end_);
+        uint64_t last = std::min(page_id + 1 + window, free_space_.end());
+        std::vector<uint64_t> pages;
+        for (uint64_t candidate = first; candidate < last; ++candidate) {
+            pages.push_back(candidate);
+        }
+        readahead_end_ = last;
+        if (pages.empty()) {
+            return;
+        }
+        try {
+            read_ahead(pages);
+            ++io_stats_.readahead_windows;
+        } catch (const std::runtime_error&) {
+            // Best effort: the caller's own fetch already succeeded
+        }
+    }
+
+    /**
+     * @brief Pins a cached page without taking the engine lock (the hit path)
+     * @param page_id ID of the page
+     * @return The pinned frame, or nullptr if the locked path has to handle
+     *         the fetch (a miss, a read-ahead page, memory_map mode)
+     */
+    BufferPool::Frame* pin_cached(uint64_t page_id) {
+        if (mapping_.is_mapped()) {
+            return nullptr;
+        }
+        BufferPool::Frame* frame = pool_.pin_resident(page_id);
+        if (frame && cache_budget_) {
+            cache_budget_->record_hit();
+        }
+        return frame;
+    }
+
+    /**
+     * @brief Returns the pinned frame holding a page, loading it on a miss
+     * @param page_id ID of the page
+     * @param load_from_disk false when the caller overwrites the whole page
+     * @param latched If given and the page was not resident, the frame is
+     *        returned exclusively latched and *latched is set (its unloaded
+     *        contents are never visible to other threads)
+     * @return Index of the pinned frame
+     * @throws std::runtime_error if the page cannot be read
+     *
+     * On a miss the CLOCK victim is written back first if it is dirty. With
+     * a memory governor, lookups are reported to the pool's budget and a
+     * miss first resizes the pool to the budget's current share.
+     *
+     * A loaded frame enters the page table only once its contents are
+     * complete, so threads on the lock-free hit path never see a partial
+     * page.
+     */
+    std::size_t fetch_frame(uint64_t page_id, bool load_from_disk, bool* latched = nullptr) {
+        std::size_t frame_id = pool_.lookup(page_id);
+        if (frame_id != BufferPool::INVALID_FRAME) {
+            pool_.pin(frame_id);
+            BufferPool::Frame& frame = pool_.frame(frame_id);
+            if (frame.prefetched.exchange(false)) {
+                // The read-ahead stood in for the first access, so this one
+                // does not count as a re-reference
+                frame.referenced = false;
+                if (load_from_disk) {
+                    ++io_stats_.prefetch_hits;
+                    track_sequential(page_id);
+                }
+            }
+            if (cache_budget_) {
+                cache_budget_->record_hit();
+            }
+            ++io_stats_.cache_hits;
+            return frame_id;
+        }
+
+        if (load_from_disk) {
+            ++io_stats_.cache_misses;
+        }
+        if (cache_budget_) {
+            if (load_from_disk) {
+                cache_budget_->record_miss();
+            }
+            if (cache_budget_->limit_units() != pool_.capacity()) {
+                resize_cache(cache_budget_->limit_units());  // Follow the governor's latest share
+            }
+        }
+
+        frame_id = claim_frame(page_id);
+        BufferPool::Frame& frame = pool_.frame(frame_id);
+        if (load_from_disk) {
+            try {
+                read_from_disk(page_id, frame.page);
+            } catch (...) {
+                pool_.invalidate(frame_id);
+                throw;
             }
+        } else if (latched) {
+            frame.latch.lock();  // Nobody else can see the frame yet, so this never waits
+            *latched = true;
         }
+        pool_.publish(frame_id);
+
+        if (load_from_disk) {
+            track_sequential(page_id);
+        }
+        return frame_id;
+    }
 
-        // If all pages are dirty, flush and evict the first one
-        uint64_t page_id = page_cache_.begin()->first;
-        flush_page(page_id);
-        page_cache_.erase(page_id);
+    /**
+     * @brief Takes a frame for a page that is not resident
+     * @param page_id Page the frame will hold
+     * @return Index of a frame assigned to the page and pinned for the
+     *         caller, but not yet in the page table (see BufferPool::publish())
+     * @throws std::runtime_error if every frame is pinned or a dirty victim
+     *         cannot be written back
+     */
+    std::size_t claim_frame(uint64_t page_id) {
+        std::size_t frame_id = pool_.acquire_victim();
+        BufferPool::Frame& frame = pool_.frame(frame_id);
+        if (frame.in_use) {
+            ++io_stats_.evictions;  // Counted once even if the write-back below fails
+            if (frame.prefetched.exchange(false)) {
+                ++io_stats_.prefetch_misses;
+            }
+        }
+        if (frame.in_use && frame.dirty) {
+            ++io_stats_.dirty_evictions;
+            try {
+                if (wal_.is_open()) {
+                    // Amortize the log sync over every dirty frame, not just the victim
+                    write_dirty_pages();
+                } else {
+                    write_to_disk(frame.page_id, frame.page);
+                    pool_.mark_clean(frame_id);
+                }
+            } catch (...) {
+                pool_.restore(frame_id);
+                throw;
+            }
+        }
+        pool_.assign(frame_id, page_id);
+        return frame_id;
+    }
+
+    /**
+     * @brief Reads a page from the file (decompressing it if needed) and validates the header
+     * @param page_id ID of the page
+     * @param page Destination
+     * @throws std::runtime_error if the page cannot be read or is invalid
+     */
+    void read_from_disk(uint64_t page_id, Page& page) {
+        if (is_compressed() && page_id != 0) {
+            PageSlot slot = page_map_.find(page_id);
+            std::vector<uint8_t> stored(slot.length);
+            if (slot.empty() || file_.read_at(stored.data(), stored.size(), slot.offset()) != stored.size()) {
+                throw std::runtime_error("Cannot read page " + std::to_string(page_id));
+            }
+            if (!decode_block(stored, {static_cast<uint8_t*>(page.raw_data()), page_size_})) {
+                throw std::runtime_error("Cannot decompress page " + std::to_string(page_id));
+            }
+            io_stats_.bytes_read += stored.size();
+        } else if (file_.read_at(page.raw_data(), page_size_, page_offset(page_id)) != page_size_) {
+            // Read from file with a single positional read
+            throw std::runtime_error("Cannot read page " + std::to_string(page_id));
+        } else {
+            io_stats_.bytes_read += page_size_;
+        }
+        ++io_stats_.pages_read;
+
+        // Validate page
+        validate_page(page_id, page);
     }
 
 private:
+    static constexpr uint64_t SEQUENTIAL_GAP = 8;        ///< Largest forward step still counted as sequential
+    static constexpr std::size_t SEQUENTIAL_TRIGGER = 2; ///< Sequential accesses before readahead starts
+    static constexpr std::size_t MIN_CACHE_FRAMES = 16;  ///< Smallest pool a memory governor may leave
+
+    StorageOptions options_;                        ///< Settings the engine was opened with
     std::string file_path_;                         ///< Path to database file
-    uint64_t next_page_id_;                         ///< Next page ID to allocate
-    uint64_t free_list_head_;                       ///< Head of free list
+    FileHandle file_;                               ///< Database file, open for the engine's lifetime
+    MappedFile mapping_;                            ///< Shared read-only mapping (memory_map mode)
+    WriteAheadLog wal_;                             ///< Redo log (closed unless enable_wal)
+    std::unique_ptr<AsyncIo> async_io_;             ///< Batched I/O backend (null for IoBackend::SYNC)
+    bool direct_io_;                                ///< file_ was opened with O_DIRECT
     uint64_t sys_tables_root_;                      ///< Root page ID for _sys_tables
     uint64_t sys_fields_root_;                      ///< Root page ID for _sys_fields
     uint64_t sys_indexes_root_;                     ///< Root page ID for _sys_indexes (NEW!)
-    std::size_t cache_size_;                        ///< Maximum cache size
-    std::unordered_map<uint64_t, Page> page_cache_; ///< Page cache
-    std::unordered_set<uint64_t> dirty_pages_;      ///< Set of dirty page IDs
+    bool metadata_dirty_;                           ///< In-memory metadata differs from page 0
+    std::size_t page_size_;                         ///< Page size of this database (from page 0)
+    PageCompression compression_;                   ///< Page codec of this database (from page 0)
+    FreeSpaceMap free_space_;                       ///< Allocation bitmap (persisted at flush time)
+    PageMap page_map_;                              ///< Page slots of a compressed database (persisted at flush time)
+    uint64_t reserved_pages_;                       ///< Pages of disk space reserved this session (at least the file size)
+    bool can_reserve_;                              ///< false once the file system refused a reservation
+    uint64_t last_access_page_;                     ///< Previous page fed to the readahead detector
+    std::size_t sequential_accesses_;               ///< Consecutive forward accesses seen so far
+    uint64_t readahead_end_;                        ///< First page past the last readahead window
+    std::size_t cache_size_;                        ///< Maximum cache size (buffer pool frames)
+    BufferPool pool_;                               ///< Frame array, page table and CLOCK state
+    std::shared_ptr<MemoryGovernor> governor_;      ///< Shared memory budget (null unless attached)
+    std::shared_ptr<MemoryBudget> cache_budget_;    ///< The buffer pool's share of governor_
+    std::unordered_map<uint64_t, Page> mapped_views_; ///< Page views into the mapping (memory_map mode)
+    IoStats io_stats_;                              ///< Disk traffic counters
+    mutable std::recursive_mutex mutex_;            ///< Engine lock (recursive: public methods call each other)
+    std::condition_variable_any writer_wakeup_;     ///< Wakes the background writer early
+    std::thread writer_;                            ///< Background writer (not started unless enabled)
+    std::mutex writer_io_mutex_;                    ///< Held by the writer while a batch is in flight
+    std::vector<Page> writer_images_;               ///< Copies of the batch being written
+    bool stop_writer_;                              ///< Tells the writer to exit (guarded by mutex_)
 };
 
 } // namespace learnql::storage
@@ -0,0 +1,186 @@
+#ifndef LEARNQL_STORAGE_STORAGE_OPTIONS_HPP
+#define LEARNQL_STORAGE_STORAGE_OPTIONS_HPP
+
+#include "Page.hpp"
+#include "AsyncIo.hpp"
+#include "PageMap.hpp"
+#include "BufferPool.hpp"
+#include <cstddef>
+#include <chrono>
+
+namespace learnql::storage {
+
+/**
+ * @brief Settings for opening a database file
+ * @details Passed to StorageEngine (or Database) at construction. The
+ *          defaults match the classic read-write engine.
+ *
+ * Example:
+ * @code
+ * // Analytics process: share the OS page cache, never write
+ * StorageOptions options;
+ * options.read_only = true;
+ * options.memory_map = true;
+ * StorageEngine engine("school.db", options);
+ * @endcode
+ */
+struct StorageOptions {
+    /**
+     * @brief Number of buffer pool frames (pages cached in memory)
+     */
+    std::size_t cache_size = 64;
+
+    /**
+     * @brief How the buffer pool chooses pages to evict
+     * @details ReplacementPolicy::TWO_Q keeps pages accessed more than once
+     *          (index nodes, the catalog) out of reach of pages a scan reads
+     *          once; ReplacementPolicy::CLOCK treats every access alike.
+     */
+    ReplacementPolicy replacement = ReplacementPolicy::TWO_Q;
+
+    /**
+     * @brief Memory shared by all of a Database's caches, in bytes (0 = off)
+     * @details When set, Database creates a MemoryGovernor that divides this
+     *          budget between the buffer pool, the node cache of every
+     *          B+tree index and query working memory, and moves memory
+     *          towards the caches that miss most. cache_size is then only
+     *          the pool's size until the governor takes over at open.
+     */
+    std::size_t memory_budget_bytes = 0;
+
+    /**
+     * @brief Part of memory_budget_bytes set aside for query working memory
+     */
+    double query_memory_fraction = 0.10;
+
+    /**
+     * @brief Page size for a new database, in bytes (power of two, 4KB-64KB)
+     * @details Recorded in page 0 when the file is created; an existing
+     *          database always opens with its recorded size. Larger pages
+     *          suit scan-heavy tables (fewer pages, shallower B+trees).
+     */
+    std::size_t page_size = PAGE_SIZE;
+
+    /**
+     * @brief Disk space reserved at a time as the database grows, in bytes
+     * @details When a newly allocated page lies past the reserved part of
+     *          the file, the engine reserves the next chunk with fallocate
+     *          (the file size itself still grows only as pages are written).
+     *          Larger chunks mean fewer, more contiguous extents. 0 turns
+     *          reservation off.
+     */
+    std::size_t growth_chunk_bytes = 1024 * 1024;
+
+    /**
+     * @brief Expected size of a new database, in bytes (0 = no hint)
+     * @details Reserved in one piece when the file is created, e.g. before a
+     *          bulk load. Ignored when opening an existing database; use
+     *          StorageEngine::reserve_space() there.
+     */
+    std::size_t size_hint_bytes = 0;
+
+    /**
+     * @brief Page compression for a new database
+     * @details With PageCompression::LZ every page except page 0 is
+     *          compressed when it is written back and stored in a slot of
+     *          512-byte sectors as long as its compressed image, so the
+     *          file shrinks by the pages' compression ratio (free space and
+     *          repeated values compress well). Pages are decompressed into
+     *          the buffer pool when read, so cached access is unchanged.
+     *          Recorded in page 0 when the file is created; an existing
+     *          database always opens with its recorded codec. Cannot be
+     *          combined with enable_wal or memory_map; direct_io is ignored
+     *          (slots are not page-aligned).
+     */
+    PageCompression compression = PageCompression::NONE;
+
+    /**
+     * @brief Open an existing file without write access
+     * @details Every mutating call throws std::runtime_error.
+     */
+    bool read_only = false;
+
+    /**
+     * @brief Serve pages straight from a shared memory mapping
+     * @details Requires read_only. Page handles point into the mapping, so
+     *          reads copy nothing and bypass the buffer pool.
+     */
+    bool memory_map = false;
+
+    /**
+     * @brief Bypass the OS page cache (O_DIRECT) for database pages
+     * @details With a large cache_size the OS would otherwise keep a second
+     *          copy of every page the engine caches. Reads and writes then
+     *          go straight between the buffer pool and the device, so only
+     *          the engine's cache holds pages (use sequential readahead and
+     *          an asynchronous io_backend to keep scans fast). Falls back to
+     *          buffered I/O on file systems without O_DIRECT (e.g. tmpfs);
+     *          StorageEngine::is_direct_io() tells which one is in use.
+     *          Cannot be combined with memory_map. The WAL stays buffered.
+     */
+    bool direct_io = false;
+
+    /**
+     * @brief Validate each page's CRC32C checksum when it is read from disk
+     * @details On by default; turn it off only for trusted fast paths (the
+     *          check costs well under a microsecond per 4KB page with SSE4.2).
+     */
+    bool verify_checksums = true;
+
+    /**
+     * @brief Keep a write-ahead log next to the database (<file>.wal)
+     * @details flush_all()/commit() then append page images to the log and
+     *          sync it once per batch instead of writing pages in place.
+     *          Ignored in read-only mode.
+     */
+    bool enable_wal = false;
+
+    /**
+     * @brief Log size that triggers an automatic checkpoint, in bytes
+     */
+    std::size_t wal_checkpoint_bytes = 64 * 1024 * 1024;
+
+    /**
+     * @brief Run a background thread that writes dirty pages ahead of eviction
+     * @details The writer starts when more than writer_high_watermark of the
+     *          frames are dirty (or every writer_interval) and writes until
+     *          at most writer_low_watermark are. Foreground calls write pages
+     *          themselves only when writer_hard_limit is reached.
+     */
+    bool background_writer = false;
+
+    double writer_low_watermark = 0.10;    ///< Fraction of frames the writer drains down to
+    double writer_high_watermark = 0.25;   ///< Fraction of dirty frames that wakes the writer
+    double writer_hard_limit = 0.75;       ///< Fraction of dirty frames at which callers stall
+    std::size_t writer_batch_pages = 32;   ///< Pages written per engine-lock hold
+    std::chrono::milliseconds writer_interval{20};  ///< Idle wake-up period
+
+    /**
+     * @brief How batched page I/O is issued
+     * @details With IO_URING (or THREAD_POOL) a flush submits all its runs
+     *          of dirty pages at once, and prefetch_pages() reads a batch of
+     *          pages in one submission (used for B+tree leaf readahead).
+     *          SYNC keeps one blocking call per run. Ignored in memory_map
+     *          mode.
+     */
+    IoBackend io_backend = IoBackend::SYNC;
+
+    unsigned io_queue_depth = 64;  ///< io_uring ring size (requests in flight)
+    unsigned io_threads = 4;       ///< Worker threads for the THREAD_POOL backend
+
+    /**
+     * @brief Pages read ahead of a sequential reader (0 disables readahead)
+     * @details When page misses move forward through the file in small
+     *          steps (a table scan, or a B+tree whose leaves were allocated
+     *          in order), the engine reads the next readahead_pages pages in
+     *          one batch and reads the following window once the reader is
+     *          halfway through it. B+tree leaf-chain walks also prefetch
+     *          this many leaves at a time when the backend is asynchronous.
+     *          IoStats::prefetch_hits/prefetch_misses show whether it pays.
+     */
+    std::size_t readahead_pages = 32;
+};
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_STORAGE_OPTIONS_HPP
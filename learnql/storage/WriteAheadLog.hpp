@@ -0,0 +1,437 @@
+#ifndef LEARNQL_STORAGE_WRITE_AHEAD_LOG_HPP
+#define LEARNQL_STORAGE_WRITE_AHEAD_LOG_HPP
+
+#include "FileHandle.hpp"
+#include <string>
+#include <vector>
+#include <span>
+#include <array>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <filesystem>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+namespace learnql::storage {
+
+/**
+ * @brief Kinds of write-ahead log records
+ */
+enum class WalRecordType : uint16_t {
+    PAGE_IMAGE = 1    ///< Full after-image of one page
+};
+
+/**
+ * @brief Append-only redo log with group commit
+ * @details Every record carries a log sequence number (LSN): its byte
+ *          position in an ever-growing logical log. The file holds the tail
+ *          of that log since the last checkpoint; its header stores the LSN
+ *          of the first byte after the header.
+ *
+ * File Layout:
+ * - Header (32 bytes): "LQLWAL01", start LSN, reserved
+ * - Records, back to back:
+ *   - magic (4) | type (2) | flags (2) | lsn (8) | page_id (8) | length (4) | checksum (4)
+ *   - payload (length bytes, e.g. a full page image)
+ *
+ * Group commit:
+ * append() only copies the record into an in-memory buffer. flush() makes
+ * everything appended so far durable. When several threads call flush() at
+ * once, one of them (the leader) writes the whole buffer and calls fdatasync
+ * while the others wait; every waiter whose records were covered returns
+ * without issuing its own fsync. N concurrent commits cost one sync.
+ *
+ * Recovery:
+ * recover() walks the records in order, stops at the first torn or corrupt
+ * record (an interrupted append), hands each valid record to a callback and
+ * then empties the log.
+ *
+ * Example:
+ * @code
+ * WriteAheadLog wal("school.db.wal", 1);
+ * uint64_t lsn = wal.append(WalRecordType::PAGE_IMAGE, page_id, page.raw_data(), PAGE_SIZE);
+ * wal.flush();   // Record is durable; the page itself can be written later
+ * @endcode
+ */
+class WriteAheadLog {
+public:
+    /**
+     * @brief Size of the file header in bytes
+     */
+    static constexpr std::size_t HEADER_SIZE = 32;
+
+    /**
+     * @brief Size of a record header in bytes
+     */
+    static constexpr std::size_t RECORD_HEADER_SIZE = 32;
+
+    /**
+     * @brief Largest payload accepted when reading a record back
+     */
+    static constexpr uint32_t MAX_PAYLOAD = 1u << 20;
+
+    /**
+     * @brief Gets the log path used for a database file
+     */
+    [[nodiscard]] static std::string path_for(const std::string& db_path) {
+        return db_path + ".wal";
+    }
+
+    /**
+     * @brief Checks whether a log file contains records awaiting recovery
+     */
+    [[nodiscard]] static bool has_records(const std::string& wal_path) {
+        std::error_code ec;
+        auto size = std::filesystem::file_size(wal_path, ec);
+        return !ec && size > HEADER_SIZE;
+    }
+
+    /**
+     * @brief Creates a closed log
+     */
+    WriteAheadLog() = default;
+
+    /**
+     * @brief Opens a log file, creating it if needed
+     * @param path Path to the log file
+     * @param start_lsn LSN of the first record when a new file is created
+     * @throws std::runtime_error if the file cannot be opened or created
+     *
+     * An existing file keeps its records; call recover() before appending.
+     */
+    WriteAheadLog(const std::string& path, uint64_t start_lsn)
+        : state_{std::make_unique<State>()} {
+        bool exists = std::filesystem::exists(path);
+        state_->file = FileHandle(path, exists ? FileHandle::read_write_flags() : FileHandle::create_flags());
+
+        if (exists && read_header()) {
+            state_->next_lsn = state_->start_lsn + (state_->file.size() > HEADER_SIZE
+                                                    ? state_->file.size() - HEADER_SIZE : 0);
+        } else {
+            reset_file(start_lsn == 0 ? 1 : start_lsn);
+        }
+        state_->buffer_lsn = state_->next_lsn;
+        state_->durable_lsn = state_->next_lsn;
+    }
+
+    // Disable copy (owns the log file)
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Allow move (the state lives on the heap so the mutex never moves)
+    WriteAheadLog(WriteAheadLog&&) noexcept = default;
+    WriteAheadLog& operator=(WriteAheadLog&&) noexcept = default;
+
+    /**
+     * @brief Checks whether a log file is open
+     */
+    [[nodiscard]] bool is_open() const noexcept {
+        return state_ != nullptr;
+    }
+
+    /**
+     * @brief Appends a record to the in-memory log buffer
+     * @param type Record type
+     * @param page_id Page the record describes
+     * @param payload Record payload
+     * @param size Payload size in bytes
+     * @return LSN of the record
+     *
+     * The record is not durable until flush() returns.
+     */
+    uint64_t append(WalRecordType type, uint64_t page_id, const void* payload, std::size_t size) {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+
+        uint64_t lsn = state_->next_lsn;
+        auto header = encode_record_header(type, lsn, page_id, payload, size);
+
+        auto& buffer = state_->buffer;
+        buffer.insert(buffer.end(), header.begin(), header.end());
+        const auto* bytes = static_cast<const uint8_t*>(payload);
+        buffer.insert(buffer.end(), bytes, bytes + size);
+
+        state_->next_lsn += RECORD_HEADER_SIZE + size;
+        ++state_->records;
+        return lsn;
+    }
+
+    /**
+     * @brief Gets the LSN the next appended record will receive
+     */
+    [[nodiscard]] uint64_t next_lsn() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->next_lsn;
+    }
+
+    /**
+     * @brief Makes every record appended so far durable (group commit)
+     * @throws std::runtime_error if the write or sync fails
+     */
+    void flush() {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        uint64_t target = state_->next_lsn;
+
+        while (state_->durable_lsn < target) {
+            if (state_->failed) {
+                throw std::runtime_error("Write-ahead log is unusable after a failed write");
+            }
+            if (state_->flushing) {
+                // Another thread is syncing; its batch may already cover us
+                state_->flushed.wait(lock);
+                continue;
+            }
+
+            // Become the leader for everything buffered so far
+            state_->flushing = true;
+            std::vector<uint8_t> batch;
+            batch.swap(state_->buffer);
+            uint64_t batch_lsn = state_->buffer_lsn;
+            uint64_t batch_end = state_->next_lsn;
+            uint64_t offset = HEADER_SIZE + (batch_lsn - state_->start_lsn);
+            state_->buffer_lsn = batch_end;
+            lock.unlock();
+
+            try {
+                if (!batch.empty()) {
+                    state_->file.write_at(batch.data(), batch.size(), offset);
+                }
+                state_->file.sync();
+            } catch (...) {
+                lock.lock();
+                state_->failed = true;
+                state_->flushing = false;
+                state_->flushed.notify_all();
+                throw;
+            }
+
+            lock.lock();
+            state_->durable_lsn = batch_end;
+            state_->flushing = false;
+            ++state_->syncs;
+            state_->flushed.notify_all();
+        }
+    }
+
+    /**
+     * @brief Replays the log and empties it
+     * @param apply Called as apply(lsn, type, page_id, payload) for each valid record, in LSN order
+     * @return Number of records replayed
+     *
+     * Must be called before any append(). Reading stops at the first record
+     * that is incomplete or fails its checksum.
+     */
+    template<typename Fn>
+    std::size_t recover(Fn&& apply) {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+
+        std::size_t count = 0;
+        uint64_t lsn = state_->start_lsn;
+        uint64_t file_size = state_->file.size();
+        std::vector<uint8_t> payload;
+
+        while (true) {
+            uint64_t offset = HEADER_SIZE + (lsn - state_->start_lsn);
+            if (offset + RECORD_HEADER_SIZE > file_size) {
+                break;
+            }
+
+            std::array<uint8_t, RECORD_HEADER_SIZE> header{};
+            if (state_->file.read_at(header.data(), header.size(), offset) != header.size()) {
+                break;
+            }
+
+            RecordFields fields = decode_record_header(header);
+            if (fields.magic != RECORD_MAGIC || fields.lsn != lsn || fields.length > MAX_PAYLOAD ||
+                offset + RECORD_HEADER_SIZE + fields.length > file_size) {
+                break;
+            }
+
+            payload.resize(fields.length);
+            if (state_->file.read_at(payload.data(), payload.size(), offset + RECORD_HEADER_SIZE) != payload.size()) {
+                break;
+            }
+
+            auto expected = encode_record_header(static_cast<WalRecordType>(fields.type), lsn,
+                                                 fields.page_id, payload.data(), payload.size());
+            if (expected != header) {
+                break;  // Torn or corrupt record
+            }
+
+            apply(lsn, static_cast<WalRecordType>(fields.type), fields.page_id,
+                  std::span<const uint8_t>(payload.data(), payload.size()));
+            ++count;
+            lsn += RECORD_HEADER_SIZE + fields.length;
+        }
+
+        reset_file(lsn);
+        state_->buffer.clear();
+        state_->buffer_lsn = lsn;
+        state_->durable_lsn = lsn;
+        return count;
+    }
+
+    /**
+     * @brief Empties the log after a checkpoint
+     * @details Records already appended must have been flushed and their
+     *          pages written to the database file. LSNs keep increasing.
+     */
+    void truncate() {
+        std::unique_lock<std::mutex> lock(state_->mutex);
+        state_->flushed.wait(lock, [this] { return !state_->flushing; });
+
+        uint64_t lsn = state_->next_lsn;
+        reset_file(lsn);
+        state_->buffer.clear();
+        state_->buffer_lsn = lsn;
+        state_->durable_lsn = lsn;
+    }
+
+    /**
+     * @brief Gets the number of bytes in the log (including unflushed records)
+     */
+    [[nodiscard]] uint64_t size_bytes() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->next_lsn - state_->start_lsn;
+    }
+
+    /**
+     * @brief Gets the number of records appended since the log was opened
+     */
+    [[nodiscard]] uint64_t record_count() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->records;
+    }
+
+    /**
+     * @brief Gets the number of fsyncs issued by flush()
+     */
+    [[nodiscard]] uint64_t sync_count() const {
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        return state_->syncs;
+    }
+
+private:
+    static constexpr std::array<char, 8> FILE_MAGIC = {'L', 'Q', 'L', 'W', 'A', 'L', '0', '1'};
+    static constexpr uint32_t RECORD_MAGIC = 0x4C57514C;  // "LQWL"
+
+    /**
+     * @brief Decoded record header fields
+     */
+    struct RecordFields {
+        uint32_t magic;
+        uint16_t type;
+        uint64_t lsn;
+        uint64_t page_id;
+        uint32_t length;
+    };
+
+    /**
+     * @brief Mutable log state (heap-allocated so the log stays movable)
+     */
+    struct State {
+        FileHandle file;                     ///< Log file
+        std::mutex mutex;                    ///< Guards everything below
+        std::condition_variable flushed;     ///< Signalled when a leader finishes a sync
+        std::vector<uint8_t> buffer;         ///< Appended records not yet written
+        uint64_t start_lsn = 1;              ///< LSN of the first byte after the file header
+        uint64_t buffer_lsn = 1;             ///< LSN of buffer[0]
+        uint64_t next_lsn = 1;               ///< LSN of the next record
+        uint64_t durable_lsn = 1;            ///< Everything below this LSN is synced
+        uint64_t records = 0;                ///< Records appended
+        uint64_t syncs = 0;                  ///< fsyncs issued
+        bool flushing = false;               ///< A leader is writing and syncing
+        bool failed = false;                 ///< A write failed; the log tail is unknown
+    };
+
+    /**
+     * @brief Reads the file header
+     * @return false if the header is missing or invalid
+     */
+    bool read_header() {
+        std::array<uint8_t, HEADER_SIZE> header{};
+        if (state_->file.read_at(header.data(), header.size(), 0) != header.size() ||
+            std::memcmp(header.data(), FILE_MAGIC.data(), FILE_MAGIC.size()) != 0) {
+            return false;
+        }
+        std::memcpy(&state_->start_lsn, header.data() + 8, sizeof(uint64_t));
+        return state_->start_lsn != 0;
+    }
+
+    /**
+     * @brief Truncates the file to an empty log starting at start_lsn
+     */
+    void reset_file(uint64_t start_lsn) {
+        std::array<uint8_t, HEADER_SIZE> header{};
+        std::memcpy(header.data(), FILE_MAGIC.data(), FILE_MAGIC.size());
+        std::memcpy(header.data() + 8, &start_lsn, sizeof(start_lsn));
+
+        if (::ftruncate(state_->file.native_handle(), 0) < 0) {
+            throw std::runtime_error("Cannot truncate write-ahead log " + state_->file.path());
+        }
+        state_->file.write_at(header.data(), header.size(), 0);
+        state_->file.sync();
+
+        state_->start_lsn = start_lsn;
+        state_->next_lsn = start_lsn;
+    }
+
+    /**
+     * @brief Serializes a record header, including the checksum of header and payload
+     */
+    static std::array<uint8_t, RECORD_HEADER_SIZE> encode_record_header(
+            WalRecordType type, uint64_t lsn, uint64_t page_id, const void* payload, std::size_t size) {
+        std::array<uint8_t, RECORD_HEADER_SIZE> header{};
+        uint32_t magic = RECORD_MAGIC;
+        auto type_value = static_cast<uint16_t>(type);
+        auto length = static_cast<uint32_t>(size);
+
+        std::memcpy(header.data() + 0, &magic, sizeof(magic));
+        std::memcpy(header.data() + 4, &type_value, sizeof(type_value));
+        std::memcpy(header.data() + 8, &lsn, sizeof(lsn));
+        std::memcpy(header.data() + 16, &page_id, sizeof(page_id));
+        std::memcpy(header.data() + 24, &length, sizeof(length));
+
+        uint32_t checksum = record_checksum(header.data(), 28, payload, size);
+        std::memcpy(header.data() + 28, &checksum, sizeof(checksum));
+        return header;
+    }
+
+    /**
+     * @brief Parses a record header (checksum is verified separately)
+     */
+    static RecordFields decode_record_header(const std::array<uint8_t, RECORD_HEADER_SIZE>& header) {
+        RecordFields fields{};
+        std::memcpy(&fields.magic, header.data() + 0, sizeof(fields.magic));
+        std::memcpy(&fields.type, header.data() + 4, sizeof(fields.type));
+        std::memcpy(&fields.lsn, header.data() + 8, sizeof(fields.lsn));
+        std::memcpy(&fields.page_id, header.data() + 16, sizeof(fields.page_id));
+        std::memcpy(&fields.length, header.data() + 24, sizeof(fields.length));
+        return fields;
+    }
+
+    /**
+     * @brief FNV-1a over the record header and payload
+     */
+    static uint32_t record_checksum(const uint8_t* header, std::size_t header_size,
+                                    const void* payload, std::size_t size) noexcept {
+        uint32_t hash = 2166136261u;
+        auto mix = [&hash](const uint8_t* bytes, std::size_t n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                hash ^= bytes[i];
+                hash *= 16777619u;
+            }
+        };
+        mix(header, header_size);
+        mix(static_cast<const uint8_t*>(payload), size);
+        return hash;
+    }
+
+    std::unique_ptr<State> state_;   ///< Log state (nullptr when closed)
+};
+
+} // namespace learnql::storage
+
+#endif // LEARNQL_STORAGE_WRITE_AHEAD_LOG_HPP
@@ -39,6 +39,7 @@ public:
      * @brief Storage statistics
      */
     struct StorageStats {
+        std::size_t page_size = storage::PAGE_SIZE;
         std::size_t total_pages = 0;
         std::size_t metadata_pages = 0;
         std::size_t data_pages = 0;
@@ -64,7 +65,7 @@ public:
 
         // Collect page information
         auto pages = collect_page_info(storage);
-        auto stats = calculate_statistics(pages);
+        auto stats = calculate_statistics(pages, storage.get_page_size());
 
         // Print summary
         print_summary(stats);
@@ -90,7 +91,7 @@ public:
      */
     static void print_compact_summary(storage::StorageEngine& storage) {
         auto pages = collect_page_info(storage);
-        auto stats = calculate_statistics(pages);
+        auto stats = calculate_statistics(pages, storage.get_page_size());
 
         std::cout << "Database Summary: "
                   << stats.total_pages << " pages | "
@@ -110,7 +111,7 @@ public:
 
         std::cout << "\nPage Allocation Map:\n";
         std::cout << std::string(80, '-') << "\n";
-        std::cout << "Legend: [M]=Metadata [D]=Data [I]=Index [O]=Overflow [F]=Free\n\n";
+        std::cout << "Legend: [M]=Metadata [S]=Free space map [D]=Data [I]=Index [O]=Overflow [F]=Free\n\n";
 
         for (std::size_t i = 0; i < pages.size(); ++i) {
             if (i % pages_per_row == 0) {
@@ -125,6 +126,7 @@ public:
                 case storage::PageType::INDEX:         symbol = 'I'; break;
                 case storage::PageType::FREE:          symbol = 'F'; break;
                 case storage::PageType::OVERFLOW_DATA: symbol = 'O'; break;
+                case storage::PageType::FREE_SPACE_MAP: symbol = 'S'; break;
             }
             std::cout << symbol;
         }
@@ -141,14 +143,27 @@ private:
         // Try to read pages until we hit an error or reach a reasonable limit
         for (uint64_t page_id = 0; page_id < 1000; ++page_id) {
             try {
-                auto page = storage.read_page(page_id);
+                if (page_id < storage.get_page_count() && !storage.is_page_allocated(page_id)) {
+                    // Free pages are only tracked in the bitmap and are not read
+                    PageInfo info;
+                    info.page_id = page_id;
+                    info.type = storage::PageType::FREE;
+                    info.record_count = 0;
+                    info.free_space_offset = 0;
+                    info.used_space = 0;
+                    info.free_space = storage.get_page_size() - sizeof(storage::PageHeader);
+                    pages.push_back(info);
+                    continue;
+                }
+
+                auto page = storage.fetch_page(page_id);
                 PageInfo info;
                 info.page_id = page_id;
-                info.type = page.header().page_type;
-                info.record_count = page.header().record_count;
-                info.free_space_offset = page.header().free_space_offset;
-                info.used_space = page.header().free_space_offset;
-                info.free_space = storage::Page::DATA_SIZE - page.header().free_space_offset;
+                info.type = page->header().page_type;
+                info.record_count = page->header().record_count;
+                info.free_space_offset = page->header().free_space_offset;
+                info.used_space = page->header().free_space_offset;
+                info.free_space = page->data_size() - page->header().free_space_offset;
                 pages.push_back(info);
             } catch (...) {
                 // End of valid pages
@@ -162,13 +177,15 @@ private:
     /**
      * @brief Calculates storage statistics from page information
      */
-    static StorageStats calculate_statistics(const std::vector<PageInfo>& pages) {
+    static StorageStats calculate_statistics(const std::vector<PageInfo>& pages, std::size_t page_size) {
         StorageStats stats;
+        stats.page_size = page_size;
         stats.total_pages = pages.size();
 
         for (const auto& page : pages) {
             switch (page.type) {
                 case storage::PageType::METADATA:
+                case storage::PageType::FREE_SPACE_MAP:
                     stats.metadata_pages++;
                     break;
                 case storage::PageType::DATA:
@@ -199,7 +216,7 @@ private:
         std::cout << "Summary\n";
         std::cout << std::string(80, '-') << "\n";
         std::cout << "Total Pages:        " << std::setw(8) << stats.total_pages << "\n";
-        std::cout << "Database Size:      " << std::setw(8) << format_bytes(stats.total_pages * storage::PAGE_SIZE) << "\n";
+        std::cout << "Database Size:      " << std::setw(8) << format_bytes(stats.total_pages * stats.page_size) << "\n";
         std::cout << "Used Space:         " << std::setw(8) << format_bytes(stats.total_used_space) << "\n";
         std::cout << "Free Space:         " << std::setw(8) << format_bytes(stats.total_free_space) << "\n";
         std::cout << "\n";
@@ -223,7 +240,7 @@ private:
             double percentage = (stats.total_pages > 0)
                 ? (static_cast<double>(count) / stats.total_pages * 100.0)
                 : 0.0;
-            std::size_t size = count * storage::PAGE_SIZE;
+            std::size_t size = count * stats.page_size;
 
             std::cout << std::setw(20) << type
                       << std::setw(12) << count
@@ -240,7 +257,7 @@ private:
         std::cout << std::setw(20) << "TOTAL"
                   << std::setw(12) << stats.total_pages
                   << std::setw(10) << "100.0%"
-                  << std::setw(15) << format_bytes(stats.total_pages * storage::PAGE_SIZE)
+                  << std::setw(15) << format_bytes(stats.total_pages * stats.page_size)
                   << "\n";
         std::cout << "\n";
     }
@@ -318,6 +335,7 @@ private:
                 case storage::PageType::INDEX:         type_str = "INDEX"; break;
                 case storage::PageType::FREE:          type_str = "FREE"; break;
                 case storage::PageType::OVERFLOW_DATA: type_str = "OVERFLOW"; break;
+                case storage::PageType::FREE_SPACE_MAP: type_str = "FSM"; break;
             }
 
             std::cout << std::setw(10) << page.page_id
@@ -337,7 +355,7 @@ private:
         std::cout << "Storage Efficiency\n";
         std::cout << std::string(80, '-') << "\n";
 
-        std::size_t total_space = stats.total_pages * storage::Page::DATA_SIZE;
+        std::size_t total_space = stats.total_pages * (stats.page_size - sizeof(storage::PageHeader));
         double utilization = (total_space > 0)
             ? (static_cast<double>(stats.total_used_space) / total_space * 100.0)
             : 0.0;
@@ -349,9 +367,9 @@ private:
         std::cout << "\n";
 
         // Space distribution
-        std::size_t data_space = stats.data_pages * storage::PAGE_SIZE;
-        std::size_t index_space = stats.index_pages * storage::PAGE_SIZE;
-        std::size_t overhead_space = (stats.metadata_pages + stats.free_pages) * storage::PAGE_SIZE;
+        std::size_t data_space = stats.data_pages * stats.page_size;
+        std::size_t index_space = stats.index_pages * stats.page_size;
+        std::size_t overhead_space = (stats.metadata_pages + stats.free_pages) * stats.page_size;
 
         std::cout << "Space Distribution:\n";
         std::cout << "  Data Pages:       " << format_bytes(data_space)